@@ -0,0 +1,73 @@
+#include "LibGraphics/Image.hpp"
+#include "LibGraphics/kernels/Grayscale.hpp"
+
+#include <opencv2/imgproc.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace LibGraphics;
+
+namespace {
+    struct Frame {
+        const char* name;
+        int width;
+        int height;
+    };
+
+    // Best of a few rounds, reported as source bytes converted per second.
+    double throughput(size_t bytes, const std::function<void()>& run) {
+        using Clock = std::chrono::steady_clock;
+
+        run();
+
+        double best = 1e30;
+        for (int round = 0; round < 5; ++round) {
+            constexpr int iterations = 10;
+            const auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i) run();
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count() / iterations;
+            if (seconds < best) best = seconds;
+        }
+
+        return static_cast<double>(bytes) / best / 1e9;
+    }
+}
+
+int main() {
+    const Frame frames[] = {{"1080p", 1920, 1080}, {"4K", 3840, 2160}};
+    std::mt19937 rng(7);
+
+    for (const Frame& frame: frames) {
+        const size_t bytes = static_cast<size_t>(frame.width) * frame.height * 3;
+
+        std::vector<uint8_t> pixels(bytes);
+        for (auto& v: pixels) v = static_cast<uint8_t>(rng());
+
+        const Image image(frame.width, frame.height, 3, pixels);
+        std::vector<uint8_t> gray(static_cast<size_t>(frame.width) * frame.height);
+
+        std::printf("%s RGB -> gray (%zu MB)\n", frame.name, bytes >> 20);
+
+        for (Kernels::Backend backend: Kernels::supportedBackends()) {
+            const double gbps = throughput(bytes, [&] {
+                for (int y = 0; y < frame.height; ++y) {
+                    Kernels::grayscaleRow(backend, pixels.data() + static_cast<size_t>(y) * frame.width * 3,
+                                          gray.data() + static_cast<size_t>(y) * frame.width, frame.width, 3, Kernels::ChannelOrder::RGB);
+                }
+            });
+            std::printf("  %-22s %6.2f GB/s\n", Kernels::backendName(backend), gbps);
+        }
+
+        std::printf("  %-22s %6.2f GB/s\n", "Image::toGrayscale", throughput(bytes, [&] { (void) image.toGrayscale(); }));
+
+        const cv::Mat src(frame.height, frame.width, CV_8UC3, pixels.data());
+        cv::Mat dst;
+        std::printf("  %-22s %6.2f GB/s\n", "cv::cvtColor", throughput(bytes, [&] { cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY); }));
+    }
+
+    return 0;
+}
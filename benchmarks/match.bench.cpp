@@ -0,0 +1,92 @@
+#include "LibGraphics/Image.hpp"
+#include "LibGraphics/match/TemplateMatcher.hpp"
+
+#include <opencv2/imgproc.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace LibGraphics;
+using namespace LibGraphics::Match;
+
+namespace {
+    constexpr int IconCount = 300;
+    constexpr int IconSize = 32;
+
+    // Best of a few rounds, in milliseconds.
+    double timeMs(const std::function<void()>& run) {
+        using Clock = std::chrono::steady_clock;
+
+        run();
+
+        double best = 1e30;
+        for (int round = 0; round < 3; ++round) {
+            const auto start = Clock::now();
+            run();
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (ms < best) best = ms;
+        }
+
+        return best;
+    }
+
+    // Blurred noise, so every icon cut from it is distinct but not flat. Nothing is cached yet, so
+    // writing through mat() needs no markDirty().
+    Image syntheticScreen(int width, int height) {
+        Image image = Image::allocate(width, height, 3);
+        cv::randu(image.mat(), 0, 256);
+        cv::GaussianBlur(image.mat(), image.mat(), cv::Size(5, 5), 0);
+        return image;
+    }
+
+    void report(const char* name, double ms, double baseline) {
+        std::printf("  %-34s %9.1f ms  %5.1fx\n", name, ms, baseline / ms);
+    }
+}
+
+int main() {
+    const Image screen = syntheticScreen(1920, 1080);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> xs(0, screen.width - IconSize);
+    std::uniform_int_distribution<int> ys(0, screen.height - IconSize);
+
+    std::vector<Image> icons;
+    std::vector<PreparedTemplate> prepared;
+    for (int i = 0; i < IconCount; ++i) {
+        icons.push_back(screen.crop(xs(rng), ys(rng), IconSize, IconSize));
+        prepared.emplace_back(icons.back());
+    }
+
+    // The same work three ways: cv::matchTemplate per icon, the prepared templates one by one,
+    // and matchMany sharing the target between them.
+    const auto compare = [&](const char* title, const cv::Rect& area, const MatchOptions& options) {
+        std::printf("%d icons of %dx%d, %s\n", IconCount, IconSize, IconSize, title);
+
+        const cv::Mat target = screen.mat()(area);
+        cv::Mat scores;
+        const double baseline = timeMs([&] {
+            for (const Image& icon: icons) cv::matchTemplate(target, icon.mat(), scores, options.getMethod());
+        });
+
+        report("cv::matchTemplate", baseline, baseline);
+        report("matchTemplateSingle(Image)", timeMs([&] {
+            for (const Image& icon: icons) (void) TemplateMatcher::matchTemplateSingle(icon, screen, options);
+        }), baseline);
+        report("matchTemplateSingle(Prepared)", timeMs([&] {
+            for (const PreparedTemplate& icon: prepared) (void) TemplateMatcher::matchTemplateSingle(icon, screen);
+        }), baseline);
+        report("matchMany", timeMs([&] { (void) TemplateMatcher::matchMany(prepared, screen, options); }), baseline);
+    };
+
+    compare("whole 1080p frame", cv::Rect(0, 0, screen.width, screen.height), MatchOptions());
+
+    // Prepared templates carry their own options, so they get the region too.
+    const Type::Rect region{640, 360, 480, 270};
+    for (PreparedTemplate& icon: prepared) icon = icon.withOptions(MatchOptions().region(region));
+    compare("480x270 search region", cv::Rect(region.X, region.Y, region.Width, region.Height), MatchOptions().region(region));
+
+    return 0;
+}
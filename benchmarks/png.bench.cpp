@@ -0,0 +1,130 @@
+#include "LibGraphics/Image.hpp"
+
+// A private copy of stb, so the baseline does not depend on how LibGraphics was built.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "LibGraphics/modules/stb_image.hpp"
+#include "LibGraphics/modules/stb_image_write.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace LibGraphics;
+
+namespace {
+#ifdef LIBGRAPHICS_WITH_SPNG
+    constexpr const char* Backend = "libspng";
+#else
+    constexpr const char* Backend = "stb";
+#endif
+
+    // Best of a few rounds, in milliseconds.
+    double timeMs(const std::function<void()>& run, int iterations) {
+        using Clock = std::chrono::steady_clock;
+
+        run();
+
+        double best = 1e30;
+        for (int round = 0; round < 3; ++round) {
+            const auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i) run();
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+            if (ms < best) best = ms;
+        }
+
+        return best;
+    }
+
+    std::vector<uint8_t> readFile(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    // Flat panels, a gradient and some text-like noise, roughly what a desktop screenshot compresses like.
+    Image syntheticScreenshot(int width, int height) {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+        uint32_t seed = 12345;
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                uint8_t* px = &pixels[(static_cast<size_t>(y) * width + x) * 3];
+                const bool panel = (x / 480 + y / 270) % 2 == 0;
+
+                px[0] = panel ? 240 : static_cast<uint8_t>(x * 255 / width);
+                px[1] = panel ? 240 : static_cast<uint8_t>(y * 255 / height);
+                px[2] = panel ? 245 : 128;
+
+                seed = seed * 1664525u + 1013904223u;
+                if (panel && (y % 24) < 12 && (seed >> 28) == 0) px[0] = px[1] = px[2] = 20;
+            }
+        }
+
+        return Image(width, height, 3, std::move(pixels));
+    }
+
+    void report(const std::string& name, const Image& image, const std::vector<uint8_t>& png) {
+        const int iterations = image.width * image.height > 1000000 ? 3 : 50;
+        const double megabytes = static_cast<double>(image.data.size()) / 1e6;
+        const std::string tmp = (std::filesystem::temp_directory_path() / "libgraphics_png_bench.png").string();
+
+        const double stbDecode = timeMs([&] {
+            int w, h, c;
+            stbi_image_free(stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &w, &h, &c, 0));
+        }, iterations);
+
+        const double libDecode = timeMs([&] { (void) Image::load_from_memory(png); }, iterations);
+
+        std::printf("%s (%dx%d, %zu KB png)\n", name.c_str(), image.width, image.height, png.size() >> 10);
+        std::printf("  decode  stb          %8.2f ms  %7.1f MB/s\n", stbDecode, megabytes / stbDecode * 1e3);
+        std::printf("  decode  %-12s %8.2f ms  %7.1f MB/s\n", Backend, libDecode, megabytes / libDecode * 1e3);
+
+        for (int level: {1, 6, 8}) {
+            stbi_write_png_compression_level = level;
+            const double stbEncode = timeMs([&] {
+                stbi_write_png(tmp.c_str(), image.width, image.height, image.channels, image.data.constData(), image.width * image.channels);
+            }, iterations);
+            const auto stbSize = std::filesystem::file_size(tmp);
+
+            Image::setPngCompressionLevel(level);
+            const double libEncode = timeMs([&] { (void) image.save(tmp); }, iterations);
+            const auto libSize = std::filesystem::file_size(tmp);
+
+            std::printf("  encode  stb          %8.2f ms  %7.1f MB/s  %8zu KB  (level %d)\n",
+                        stbEncode, megabytes / stbEncode * 1e3, static_cast<size_t>(stbSize >> 10), level);
+            std::printf("  encode  %-12s %8.2f ms  %7.1f MB/s  %8zu KB  (level %d)\n",
+                        Backend, libEncode, megabytes / libEncode * 1e3, static_cast<size_t>(libSize >> 10), level);
+        }
+
+        std::filesystem::remove(tmp);
+    }
+}
+
+int main(int argc, char** argv) {
+    // Run from the build directory like the tests, or pass the asset directory.
+    const std::filesystem::path assets = argc > 1 ? argv[1] : "../tests/assets";
+
+    for (const auto& entry: std::filesystem::recursive_directory_iterator(assets)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".png") continue;
+
+        const std::vector<uint8_t> png = readFile(entry.path());
+        report(entry.path().lexically_relative(assets).string(), Image::load_from_memory(png), png);
+    }
+
+    const Image screenshot = syntheticScreenshot(3840, 2160);
+    const std::string tmp = (std::filesystem::temp_directory_path() / "libgraphics_png_bench_4k.png").string();
+    Image::setPngCompressionLevel(8);
+    if (screenshot.save(tmp)) {
+        report("synthetic 4K screenshot", screenshot, readFile(tmp));
+        std::filesystem::remove(tmp);
+    }
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+message(STATUS "⏱️  Building LibGraphics benchmarks")
+
+function(libgraphics_add_benchmark name)
+    add_executable(${name} ${ARGN})
+
+    target_include_directories(${name}
+            PRIVATE
+            ${CMAKE_CURRENT_SOURCE_DIR}/include/private
+            ${CMAKE_CURRENT_SOURCE_DIR}/include/public
+            ${OpenCV_INCLUDE_DIRS}
+    )
+
+    target_link_libraries(${name}
+            PRIVATE
+            LibGraphics
+            ${OpenCV_LIBS}
+    )
+
+    # Lets a benchmark label which backend it is measuring.
+    if (LIBGRAPHICS_WITH_SPNG)
+        target_compile_definitions(${name} PRIVATE LIBGRAPHICS_WITH_SPNG)
+    endif ()
+endfunction()
+
+libgraphics_add_benchmark(graphics_bench_grayscale benchmarks/grayscale.bench.cpp)
+libgraphics_add_benchmark(graphics_bench_png benchmarks/png.bench.cpp)
+libgraphics_add_benchmark(graphics_bench_match benchmarks/match.bench.cpp)
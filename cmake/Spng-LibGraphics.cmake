@@ -0,0 +1,36 @@
+message(STATUS "  🔨 Linking libspng")
+
+if (WIN32)
+    # Windows (vcpkg): use SPNGConfig.cmake
+    find_package(SPNG CONFIG REQUIRED)
+
+    if (TARGET spng::spng)
+        target_link_libraries(LibGraphics PRIVATE spng::spng)
+    else()
+        target_link_libraries(LibGraphics PRIVATE spng::spng_static)
+    endif()
+
+else()
+    # Linux/macOS: use pkg-config
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(SPNG REQUIRED spng)
+
+    target_include_directories(LibGraphics PRIVATE
+            ${SPNG_INCLUDE_DIRS}
+    )
+
+    target_link_directories(LibGraphics PRIVATE
+            ${SPNG_LIBRARY_DIRS}
+    )
+
+    target_link_libraries(LibGraphics PRIVATE
+            ${SPNG_LIBRARIES}
+    )
+endif()
+
+target_sources(LibGraphics PRIVATE
+        include/private/LibGraphics/io/SpngCodec.hpp
+        src/io/SpngCodec.cpp
+)
+
+target_compile_definitions(LibGraphics PRIVATE LIBGRAPHICS_WITH_SPNG)
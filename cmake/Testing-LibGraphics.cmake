@@ -17,11 +17,23 @@ add_executable(graphics_testsuite
         tests/color/BackgroundScanner.wrappers.test.cpp
         tests/match/MatchResult.test.cpp
         tests/match/TemplateMatcher.test.cpp
+        tests/match/PreparedTemplate.test.cpp
+        tests/match/Correlation.test.cpp
         tests/type/Region.test.cpp
         tests/type/Rect.test.cpp
+        tests/type/PixelBuffer.test.cpp
         tests/utils/Converter.test.cpp
+        tests/memory/BufferPool.test.cpp
+        tests/io/MappedFile.test.cpp
+        tests/kernels/Channels.test.cpp
+        tests/kernels/Dispatch.test.cpp
+        tests/kernels/Grayscale.test.cpp
+        tests/kernels/Redact.test.cpp
         tests/ocr/OcrTextReader.test.cpp
         tests/image.test.cpp
+        tests/basicimage.test.cpp
+        tests/imageview.test.cpp
+        tests/integralimage.test.cpp
 )
 
 # Include paths for tests
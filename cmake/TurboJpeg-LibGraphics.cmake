@@ -0,0 +1,36 @@
+message(STATUS "  🔨 Linking libjpeg-turbo")
+
+if (WIN32)
+    # Windows (vcpkg): use libjpeg-turboConfig.cmake
+    find_package(libjpeg-turbo CONFIG REQUIRED)
+
+    if (TARGET libjpeg-turbo::turbojpeg)
+        target_link_libraries(LibGraphics PRIVATE libjpeg-turbo::turbojpeg)
+    else()
+        target_link_libraries(LibGraphics PRIVATE libjpeg-turbo::turbojpeg-static)
+    endif()
+
+else()
+    # Linux/macOS: use pkg-config
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(TURBOJPEG REQUIRED libturbojpeg)
+
+    target_include_directories(LibGraphics PRIVATE
+            ${TURBOJPEG_INCLUDE_DIRS}
+    )
+
+    target_link_directories(LibGraphics PRIVATE
+            ${TURBOJPEG_LIBRARY_DIRS}
+    )
+
+    target_link_libraries(LibGraphics PRIVATE
+            ${TURBOJPEG_LIBRARIES}
+    )
+endif()
+
+target_sources(LibGraphics PRIVATE
+        include/private/LibGraphics/io/TurboJpegDecoder.hpp
+        src/io/TurboJpegDecoder.cpp
+)
+
+target_compile_definitions(LibGraphics PRIVATE LIBGRAPHICS_WITH_TURBOJPEG)
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "LibGraphics/Image.hpp"
+
+#include <opencv2/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace LibGraphics::Detail {
+
+    /**
+     * Derived representations of an Image. The cache is stored as the
+     * attachment of the pixel buffer it was built from, so copies of an Image
+     * that still share their pixels also share this cache.
+     *
+     * Each slot is filled exactly once under its own once_flag, so any number
+     * of threads may ask for it concurrently; after the first fill the cost is
+     * a single acquire load. In-place mutators run on an unshared buffer and
+     * are not concurrent with readers, they may touch the slots directly.
+     *
+     * Images reading one buffer with different geometries each get their own
+     * cache, chained through `next` behind the attachment. A published cache
+     * is never replaced, so the references mat() and friends hand out stay
+     * valid as long as the pixels do.
+     *
+     * The pyramid and the integral tables can be dropped again by
+     * Image::markDirty(), which a once_flag cannot express, so they are
+     * guarded by a mutex instead; levels[i] is pyramid level i + 1.
+     */
+    struct ImageCache {
+        const uint8_t* source = nullptr;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        size_t stride = 0;
+        std::shared_ptr<ImageCache> next;  // Cache of another geometry over the same pixels
+
+        std::once_flag colorOnce;
+        cv::Mat color;
+
+        std::once_flag grayOnce;
+        cv::Mat gray;
+
+        std::once_flag planesOnce;
+        std::vector<cv::Mat> planes;
+
+        std::mutex pyramidMutex;
+        std::vector<Image> levels;
+
+        std::mutex integralMutex;
+        IntegralImage integral;
+        IntegralImage grayIntegral;
+
+        [[nodiscard]] bool matches(const uint8_t* data, int w, int h, int c, size_t rowStride) const {
+            return source == data && width == w && height == h && channels == c && stride == rowStride;
+        }
+    };
+}
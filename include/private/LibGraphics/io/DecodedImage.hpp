@@ -0,0 +1,21 @@
+#pragma once
+
+#include "LibGraphics/type/PixelBuffer.hpp"
+
+#include <cstddef>
+
+namespace LibGraphics::IO {
+
+    /**
+     * Output of an optional decoder backend, before it becomes an Image.
+     * An empty `pixels` buffer means the backend could not (or chose not to)
+     * decode the input and the stb_image path should be used instead.
+     */
+    struct DecodedImage {
+        Type::PixelBuffer pixels;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        size_t stride = 0;  // 0 when the rows are packed
+    };
+}
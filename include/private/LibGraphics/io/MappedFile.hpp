@@ -0,0 +1,49 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LibGraphics::IO {
+
+    /**
+     * @brief Read-only view of a whole file, memory-mapped when the platform allows it.
+     *
+     * On POSIX the file is mmap()ed and advised MADV_SEQUENTIAL, on Windows it
+     * goes through a file mapping. Decoders read straight from the page cache
+     * instead of through stdio buffers. Files that cannot be mapped (pipes,
+     * some network mounts) are read into memory instead, so callers never
+     * have to care which one they got.
+     */
+    class LIBGRAPHICS_API MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] bool isOpen() const { return open_; }
+        [[nodiscard]] bool isMapped() const { return mapping_ != nullptr; }
+
+        [[nodiscard]] const uint8_t* data() const { return data_; }
+        [[nodiscard]] size_t size() const { return size_; }
+
+    private:
+        bool open_ = false;
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+
+        void* mapping_ = nullptr;
+        std::vector<uint8_t> fallback_;
+
+#ifdef _WIN32
+        void* mappingHandle_ = nullptr;
+#endif
+
+        void readFallback(const std::string& path);
+    };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "LibGraphics/io/DecodedImage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LibGraphics::IO {
+
+    /**
+     * True when the bytes start with the PNG signature.
+     */
+    bool isPng(const uint8_t* data, size_t size);
+
+    /**
+     * Decodes a PNG with libspng into the channel layout Image would end up
+     * with after stb_image and alpha stripping (RGB, or gray for 8-bit gray
+     * files). Gray images with transparency and 16-bit gray are left to
+     * stb_image, as are files libspng rejects: the result is empty then.
+     *
+     * Only compiled when LIBGRAPHICS_WITH_SPNG is enabled.
+     */
+    DecodedImage decodeSpng(const uint8_t* data, size_t size);
+
+    /**
+     * Encodes 8-bit interleaved pixels (1-4 channels), rows `stride` bytes
+     * apart, as PNG at the given zlib compression level (0-9). Returns an
+     * empty vector on failure.
+     */
+    std::vector<uint8_t> encodeSpng(const uint8_t* pixels, int width, int height, int channels, size_t stride, int level);
+}
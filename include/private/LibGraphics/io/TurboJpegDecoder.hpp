@@ -0,0 +1,24 @@
+#pragma once
+
+#include "LibGraphics/LoadOptions.hpp"
+#include "LibGraphics/io/DecodedImage.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LibGraphics::IO {
+
+    /**
+     * True when the bytes start with a JPEG SOI marker.
+     */
+    bool isJpeg(const uint8_t* data, size_t size);
+
+    /**
+     * Decodes a JPEG with libjpeg-turbo, applying LoadOptions inside the
+     * decoder. Pixels land in a PixelBuffer from the current allocator.
+     * Returns an empty result when the data cannot be decoded.
+     *
+     * Only compiled when LIBGRAPHICS_WITH_TURBOJPEG is enabled.
+     */
+    DecodedImage decodeTurboJpeg(const uint8_t* data, size_t size, const LoadOptions& options);
+}
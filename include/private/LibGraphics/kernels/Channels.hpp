@@ -0,0 +1,24 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+#include "LibGraphics/kernels/CpuFeatures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LibGraphics::Kernels {
+
+    /**
+     * Drops the fourth byte of `pixels` interleaved 4-channel pixels, writing
+     * 3 * pixels bytes to `dst`. `dst` may equal `src`: the kernels work front
+     * to back and only ever store over bytes they have already read, which is
+     * what lets Image compact a decoded RGBA frame inside its own buffer.
+     * Never writes past dst + 3 * pixels.
+     */
+    LIBGRAPHICS_API void stripAlpha(Backend backend, const uint8_t* src, uint8_t* dst, size_t pixels);
+
+    /**
+     * stripAlpha() with the best backend for this CPU.
+     */
+    LIBGRAPHICS_API void stripAlpha(const uint8_t* src, uint8_t* dst, size_t pixels);
+}
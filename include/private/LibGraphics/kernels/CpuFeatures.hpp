@@ -0,0 +1,41 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+
+#include <vector>
+
+namespace LibGraphics::Kernels {
+
+    /**
+     * Instruction set a pixel kernel was built for. Kernels are compiled for
+     * every backend the compiler can target and the best one the running CPU
+     * supports is picked once, at first use.
+     */
+    enum class Backend {
+        Scalar,
+        SSE41,
+        AVX2,
+        AVX512,
+        NEON
+    };
+
+    LIBGRAPHICS_API bool isSupported(Backend backend);
+    LIBGRAPHICS_API Backend bestBackend();
+    LIBGRAPHICS_API std::vector<Backend> supportedBackends();
+    LIBGRAPHICS_API const char* backendName(Backend backend);
+}
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define LIBGRAPHICS_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define LIBGRAPHICS_NEON 1
+#endif
+
+// Lets a single function use instructions beyond the translation unit's baseline (GCC/Clang).
+#if defined(__GNUC__) || defined(__clang__)
+#define LIBGRAPHICS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define LIBGRAPHICS_TARGET(isa)
+#endif
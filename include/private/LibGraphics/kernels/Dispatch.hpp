@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace LibGraphics::Kernels {
+
+    /**
+     * Channel count as a type, so a kernel instantiated with it gets a constant
+     * pixel stride and fixed-length inner loops the compiler can unroll.
+     */
+    template <int N>
+    using ChannelCount = std::integral_constant<int, N>;
+
+    /**
+     * Calls `kernel(ChannelCount<N>{})` for N = `channels` (1 to 4). Branch once
+     * per call here instead of on the runtime count inside the pixel loop.
+     */
+    template <typename Kernel>
+    decltype(auto) dispatchChannels(int channels, Kernel &&kernel) {
+        switch (channels) {
+            case 1: return kernel(ChannelCount<1>{});
+            case 2: return kernel(ChannelCount<2>{});
+            case 3: return kernel(ChannelCount<3>{});
+            case 4: return kernel(ChannelCount<4>{});
+            default: throw std::invalid_argument("[Kernels::dispatchChannels] Unsupported channel count");
+        }
+    }
+
+    /**
+     * Like dispatchChannels() for kernels that write only the first
+     * `colorChannels` bytes of each `channels`-byte pixel (e.g. 3 of 4 to keep
+     * alpha): calls `kernel(ChannelCount<channels>{}, ChannelCount<colorChannels>{})`.
+     */
+    template <typename Kernel>
+    void dispatchLayout(int channels, int colorChannels, Kernel &&kernel) {
+        dispatchChannels(channels, [&](auto c) {
+            dispatchChannels(colorChannels, [&](auto cc) {
+                if constexpr (std::decay_t<decltype(cc)>::value <= std::decay_t<decltype(c)>::value)
+                    kernel(c, cc);
+                else
+                    throw std::invalid_argument("[Kernels::dispatchLayout] More colour channels than channels");
+            });
+        });
+    }
+
+    /**
+     * Pixel `x` of row `y` in an interleaved buffer with a byte stride.
+     */
+    template <int Channels, typename Byte>
+    Byte *pixelAt(Byte *base, size_t stride, int x, int y) {
+        return base + static_cast<size_t>(y) * stride + static_cast<size_t>(x) * Channels;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+#include "LibGraphics/kernels/CpuFeatures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LibGraphics::Kernels {
+
+    /**
+     * Which of the first three bytes of a pixel is red. Image data is RGB, but
+     * Image::mat() hands those bytes to OpenCV as BGR, so matGray() weighs them
+     * the way cv::COLOR_BGR2GRAY would.
+     */
+    enum class ChannelOrder {
+        RGB,
+        BGR
+    };
+
+    // Rec.601 luma weights in Q15; they add up to exactly 1 << 15 so white stays 255.
+    constexpr int GrayShift = 15;
+    constexpr int GrayWeightR = 9798;   // 0.299
+    constexpr int GrayWeightG = 19235;  // 0.587
+    constexpr int GrayWeightB = 3735;   // 0.114
+    constexpr int GrayRound = 1 << (GrayShift - 1);
+
+    /**
+     * Reference formula every backend reproduces bit for bit.
+     */
+    inline uint8_t grayPixel(int r, int g, int b) {
+        return static_cast<uint8_t>((r * GrayWeightR + g * GrayWeightG + b * GrayWeightB + GrayRound) >> GrayShift);
+    }
+
+    /**
+     * Converts one row of `width` interleaved pixels (1, 3 or 4 channels, alpha
+     * ignored) to 8-bit luma with the given backend, which must be supported.
+     */
+    LIBGRAPHICS_API void grayscaleRow(Backend backend, const uint8_t* src, uint8_t* dst, int width, int channels, ChannelOrder order);
+
+    /**
+     * Converts a whole frame with the best backend for this CPU. Both strides are
+     * in bytes, so the source may be a cropped view.
+     */
+    LIBGRAPHICS_API void grayscale(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                                   int width, int height, int channels, ChannelOrder order);
+}
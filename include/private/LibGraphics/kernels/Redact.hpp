@@ -0,0 +1,69 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+#include "LibGraphics/type/Rect.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LibGraphics::Kernels {
+
+    /**
+     * Pixels [x0, x1) of row y.
+     */
+    struct RowSpan {
+        int y;
+        int x0;
+        int x1;
+    };
+
+    /**
+     * Clips `rects` to a width x height frame and returns the pixels they cover
+     * as disjoint spans, sorted by row and then by x. Overlapping or touching
+     * rectangles end up in the same span, so every pixel is listed once.
+     */
+    LIBGRAPHICS_API std::vector<RowSpan> mergeSpans(const std::vector<Type::Rect>& rects, int width, int height);
+
+    /**
+     * Clips `rects` to the frame and merges them into bounding boxes until no
+     * box, grown by `margin` on every side, overlaps another one.
+     */
+    LIBGRAPHICS_API std::vector<Type::Rect> mergeRects(const std::vector<Type::Rect>& rects, int width, int height, int margin = 0);
+
+    /*
+     * The span kernels below work on interleaved 8-bit pixels with a row stride
+     * in bytes. Only the first `colorChannels` (at most 4) bytes of each pixel
+     * are written (pass 3 for RGBA to keep the alpha channel); all channels when
+     * it equals `channels`, which is the fast path.
+     */
+
+    /**
+     * Paints every span with `color` (colorChannels bytes).
+     */
+    LIBGRAPHICS_API void fillSpans(uint8_t* pixels, size_t stride, int channels, int colorChannels,
+                                   const std::vector<RowSpan>& spans, const uint8_t* color);
+
+    constexpr int MaxPixelBlock = 4096;
+
+    /**
+     * Replaces the covered part of every `block` x `block` cell (aligned to the
+     * frame origin) with the rounded mean of the covered pixels of that cell.
+     * `spans` must come from mergeSpans(); `block` must not exceed MaxPixelBlock.
+     */
+    LIBGRAPHICS_API void pixelateSpans(uint8_t* pixels, size_t stride, int width, int channels, int colorChannels,
+                                       const std::vector<RowSpan>& spans, int block);
+
+    // Keeps one window's sum of 8-bit values inside 32 bits.
+    constexpr int MaxBlurRadius = 2048;
+
+    /**
+     * Replaces every covered pixel with the rounded mean of the (2 radius + 1)^2
+     * window around it in the original image, clipped to the frame. Only
+     * original pixels are ever sampled, whatever the order the spans come in.
+     * `spans` must come from mergeSpans() on the same `rects`; `radius` must
+     * not exceed MaxBlurRadius.
+     */
+    LIBGRAPHICS_API void blurSpans(uint8_t* pixels, size_t stride, int width, int height, int channels, int colorChannels,
+                                   const std::vector<Type::Rect>& rects, const std::vector<RowSpan>& spans, int radius);
+}
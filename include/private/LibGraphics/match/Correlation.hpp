@@ -0,0 +1,196 @@
+#pragma once
+
+#include "LibGraphics/Image.hpp"
+#include "LibGraphics/ImageView.hpp"
+#include "LibGraphics/IntegralImage.hpp"
+
+#include <opencv2/core.hpp>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace LibGraphics::Match::Detail {
+
+    /*
+     * Template matching by FFT correlation with cached spectra.
+     *
+     * Scores follow cv::matchTemplate exactly: the correlation comes from one
+     * DFT product per channel, and the window sums the normalisation needs
+     * come from the target's summed-area tables, as in OpenCV's own
+     * common_matchTemplate(). Both sides are correlated with their mean
+     * removed, which leaves the result unchanged (the zero-mean template sums
+     * to zero) but keeps the float DFT error proportional to the contrast of
+     * the images instead of their brightness.
+     *
+     * The DFT size only depends on the searched region, never on the template,
+     * so one set of target spectra serves every template matched against it.
+     */
+
+    /**
+     * Channel count both sides are matched in, following the conversions the
+     * matcher has always applied: grayscale, or the smaller of 3 and 4 (alpha
+     * dropped), or 1 when either side is gray.
+     */
+    int workingChannels(int templateChannels, int targetChannels, bool grayscale);
+
+    /**
+     * Converts an 8-bit BGR(A)/gray Mat to `channels` channels (1, 3 or 4).
+     */
+    cv::Mat toChannels(const cv::Mat& mat, int channels);
+
+    /**
+     * An Image in `channels` channels; gray comes from the cached matGray() plane.
+     */
+    cv::Mat workingMat(const Image& image, int channels);
+
+    /**
+     * Per-template constants of the normalisation, see common_matchTemplate().
+     */
+    struct TemplateStats {
+        cv::Scalar mean;
+        double variance = 0;   // Sum over the channels of the per-channel variance
+        double sum2 = 0;       // Sum of the squared pixel values
+        double area = 0;
+    };
+
+    TemplateStats templateStats(const cv::Mat& templ);
+
+    /**
+     * Turns the zero-mean correlation `scores` (rows x cols, CV_32F) into
+     * `method` scores in place. `sum`/`sqsum` are the target's CV_64F
+     * summed-area tables with `channels` channels; result (x, y) is the window
+     * whose top left corner is at (x + offset.x, y + offset.y) in them.
+     */
+    void normalizeScores(float* scores, size_t scoreStep, int cols, int rows,
+                         const double* sum, size_t sumStep, const double* sqsum, size_t sqsumStep,
+                         int channels, cv::Point offset, cv::Size templSize,
+                         const TemplateStats& stats, int method);
+
+    /**
+     * One template in one working format, with its statistics. Shared by
+     * every match that uses the template.
+     */
+    class TemplateFormat {
+    public:
+        explicit TemplateFormat(cv::Mat mat);
+
+        [[nodiscard]] const cv::Mat& mat() const { return mat_; }
+        [[nodiscard]] const TemplateStats& stats() const { return stats_; }
+
+        /**
+         * Spectra (one CCS plane per channel) of the zero-mean template padded to `dftSize`.
+         */
+        [[nodiscard]] std::vector<cv::Mat> spectra(cv::Size dftSize) const;
+
+    private:
+        cv::Mat mat_;
+        TemplateStats stats_;
+    };
+
+    /**
+     * Spectra of a template for one matching call, built per DFT size on
+     * first use. Regions and tiles of the same size reuse them; they are
+     * released with the call, so a prepared template never holds on to
+     * spectra the size of a frame.
+     */
+    class TemplateSpectra {
+    public:
+        explicit TemplateSpectra(const TemplateFormat& format) : format_(format) {}
+
+        [[nodiscard]] const TemplateFormat& format() const { return format_; }
+        [[nodiscard]] std::shared_ptr<const std::vector<cv::Mat>> at(cv::Size dftSize) const;
+
+    private:
+        const TemplateFormat& format_;
+
+        mutable std::mutex mutex_;
+        mutable std::map<std::pair<int, int>, std::shared_ptr<const std::vector<cv::Mat>>> spectra_;
+    };
+
+    /**
+     * Everything a PreparedTemplate caches: the source image and one
+     * TemplateFormat per working channel count, built on first use.
+     */
+    class TemplateState {
+    public:
+        explicit TemplateState(Image image);
+
+        [[nodiscard]] const Image& image() const { return image_; }
+        [[nodiscard]] const TemplateFormat& format(int channels) const;
+
+    private:
+        Image image_;
+        mutable std::array<std::once_flag, 5> once_;
+        mutable std::array<std::unique_ptr<TemplateFormat>, 5> formats_;
+    };
+
+    /**
+     * Target side of a match in one working format: pixels, summed-area
+     * tables and, when `cacheSpectra` is set, the spectra of the shared
+     * regions searched so far. Safe to share between threads matching different
+     * templates.
+     *
+     * The state may cover only part of the target, the `bounds` of the search
+     * regions; `origin` is where its top-left corner sits. Regions passed in
+     * are in target coordinates and must lie inside the bounds.
+     */
+    class TargetState {
+    public:
+        TargetState(cv::Mat mat, IntegralImage tables, bool cacheSpectra = true, cv::Point origin = cv::Point());
+
+        /**
+         * Target in the working format of `channels`, over `bounds` only. Image
+         * targets reuse their pixels, and their cached gray plane when the
+         * bounds are the whole frame. The summed-area tables are built for the
+         * state and dropped with it, never cached on the Image.
+         */
+        static std::shared_ptr<TargetState> fromImage(const Image& image, int channels, const cv::Rect& bounds,
+                                                      bool cacheSpectra = true);
+        static std::shared_ptr<TargetState> fromView(const ImageView& view, int channels, const cv::Rect& bounds,
+                                                     bool cacheSpectra = true);
+
+        [[nodiscard]] const cv::Mat& mat() const { return mat_; }
+        [[nodiscard]] const IntegralImage& tables() const { return tables_; }
+        [[nodiscard]] cv::Point origin() const { return origin_; }
+
+        /**
+         * The pixels of `region`, given in target coordinates.
+         */
+        [[nodiscard]] cv::Mat roi(const cv::Rect& region) const { return mat_(region - origin_); }
+
+        /**
+         * Spectra of the zero-mean `region` padded to `dftSize`. Only regions
+         * other templates will search too should be `share`d; the rest (refine
+         * windows) are computed without being stored.
+         */
+        [[nodiscard]] std::shared_ptr<const std::vector<cv::Mat>> spectra(const cv::Rect& region, cv::Size dftSize,
+                                                                          bool share) const;
+
+        /**
+         * Number of regions whose spectra are kept.
+         */
+        [[nodiscard]] size_t cachedRegions() const;
+
+    private:
+        cv::Mat mat_;
+        IntegralImage tables_;
+        bool cacheSpectra_;
+        cv::Point origin_;
+
+        mutable std::mutex mutex_;
+        mutable std::map<std::array<int, 4>, std::shared_ptr<const std::vector<cv::Mat>>> spectra_;
+    };
+
+    /**
+     * cv::matchTemplate(target(region), templ, result, method) through the caches.
+     * `region` must be inside the target's bounds and at least as large as the template;
+     * `shareRegion` lets the target keep its spectra for the next template.
+     */
+    cv::Mat scoreMap(const TemplateSpectra& templ, const TargetState& target, const cv::Rect& region, int method,
+                     bool shareRegion = false);
+}
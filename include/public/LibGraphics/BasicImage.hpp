@@ -0,0 +1,232 @@
+#pragma once
+
+#include "LibGraphics/Image.hpp"
+
+#include <opencv2/core.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LibGraphics {
+
+    namespace Detail {
+        template<typename T>
+        struct PixelDepth;
+
+        template<> struct PixelDepth<uint8_t> { static constexpr int value = CV_8U; };
+        template<> struct PixelDepth<uint16_t> { static constexpr int value = CV_16U; };
+        template<> struct PixelDepth<float> { static constexpr int value = CV_32F; };
+    }
+
+    /**
+     * @brief Packed interleaved image with `T` per channel: uint8_t, uint16_t or float.
+     *
+     * The working format for preprocessing that does not fit in 8 bits:
+     * normalisation, running sums over many frames, signed or fractional
+     * difference images. Convert an Image in with from(), do the arithmetic in
+     * place (no allocations once the destination exists) and come back with
+     * toImage(). Channels keep the storage order of the Image they came from.
+     *
+     * Unlike Image this is a plain value type: copies own their pixels and
+     * there are no derived caches or codecs. Arithmetic goes through OpenCV,
+     * so integer results saturate to the range of `T`. Size or channel
+     * mismatches throw std::invalid_argument.
+     */
+    template<typename T>
+    class BasicImage {
+        static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, float>,
+                      "BasicImage supports uint8_t, uint16_t and float pixels");
+
+    public:
+        using value_type = T;
+
+        // OpenCV depth (CV_8U, CV_16U, CV_32F) of one channel.
+        static constexpr int Depth = Detail::PixelDepth<T>::value;
+
+        BasicImage() = default;
+
+        BasicImage(int width, int height, int channels, T value = T{})
+            : width_(width), height_(height), channels_(channels) {
+            checkSize(width, height, channels, "BasicImage");
+            pixels_.assign(count(), value);
+        }
+
+        /**
+         * @brief Takes `pixels` as rows of width * channels values; the size must match exactly.
+         */
+        BasicImage(int width, int height, int channels, std::vector<T> pixels)
+            : width_(width), height_(height), channels_(channels), pixels_(std::move(pixels)) {
+            checkSize(width, height, channels, "BasicImage");
+            if (pixels_.size() != count())
+                throw std::invalid_argument("[BasicImage::BasicImage] Pixel count does not match the size");
+        }
+
+        /**
+         * @brief Converts an 8-bit image as `value * scale + offset`, e.g. scale 1/255 for [0, 1] floats.
+         *
+         * Any row stride is accepted; the result is always packed.
+         */
+        static BasicImage from(const Image& image, double scale = 1.0, double offset = 0.0) {
+            if (!image.isValid())
+                throw std::invalid_argument("[BasicImage::from] Invalid image");
+
+            BasicImage out(image.width, image.height, image.channels);
+            cv::Mat dst = out.mat();
+            imageMat(image).convertTo(dst, Depth, scale, offset);
+            return out;
+        }
+
+        /**
+         * @brief Back to 8 bits as `value * scale + offset`, rounded and saturated to 0-255.
+         */
+        [[nodiscard]] Image toImage(double scale = 1.0, double offset = 0.0) const {
+            if (!isValid())
+                throw std::invalid_argument("[BasicImage::toImage] Invalid image");
+
+            Image out = Image::allocate(width_, height_, channels_);
+            cv::Mat dst(height_, width_, CV_8UC(channels_), out.rowPtr(0), out.rowStride());
+            mat().convertTo(dst, CV_8U, scale, offset);
+            out.origin = "basic";
+            return out;
+        }
+
+        /**
+         * @brief Same pixels as another type, `value * scale + offset`, saturated for integer targets.
+         */
+        template<typename U>
+        [[nodiscard]] BasicImage<U> convert(double scale = 1.0, double offset = 0.0) const {
+            if (!isValid())
+                throw std::invalid_argument("[BasicImage::convert] Invalid image");
+
+            BasicImage<U> out(width_, height_, channels_);
+            cv::Mat dst = out.mat();
+            mat().convertTo(dst, BasicImage<U>::Depth, scale, offset);
+            return out;
+        }
+
+        [[nodiscard]] bool isValid() const { return !pixels_.empty(); }
+        explicit operator bool() const { return isValid(); }
+
+        [[nodiscard]] int width() const { return width_; }
+        [[nodiscard]] int height() const { return height_; }
+        [[nodiscard]] int channels() const { return channels_; }
+        [[nodiscard]] bool sameShape(const BasicImage& other) const {
+            return width_ == other.width_ && height_ == other.height_ && channels_ == other.channels_;
+        }
+
+        [[nodiscard]] const std::vector<T>& pixels() const { return pixels_; }
+        [[nodiscard]] T* data() { return pixels_.data(); }
+        [[nodiscard]] const T* data() const { return pixels_.data(); }
+
+        [[nodiscard]] T* row(int y) { return pixels_.data() + static_cast<size_t>(y) * width_ * channels_; }
+        [[nodiscard]] const T* row(int y) const { return pixels_.data() + static_cast<size_t>(y) * width_ * channels_; }
+
+        [[nodiscard]] T& at(int x, int y, int channel = 0) { return row(y)[static_cast<size_t>(x) * channels_ + channel]; }
+        [[nodiscard]] const T& at(int x, int y, int channel = 0) const { return row(y)[static_cast<size_t>(x) * channels_ + channel]; }
+
+        /**
+         * @brief Typed header over the pixels (CV_8UC(n), CV_16UC(n) or CV_32FC(n)), no copy.
+         *
+         * Writes through the header change this image. The const overload hands
+         * out the same kind of header; do not write through it.
+         */
+        [[nodiscard]] cv::Mat mat() {
+            return cv::Mat(height_, width_, CV_MAKETYPE(Depth, channels_), pixels_.data());
+        }
+
+        [[nodiscard]] cv::Mat mat() const {
+            return cv::Mat(height_, width_, CV_MAKETYPE(Depth, channels_), const_cast<T*>(pixels_.data()));
+        }
+
+        void fill(T value) { std::fill(pixels_.begin(), pixels_.end(), value); }
+
+        BasicImage& operator+=(const BasicImage& other) {
+            checkShape(other, "operator+=");
+            cv::Mat dst = mat();
+            cv::add(dst, other.mat(), dst);
+            return *this;
+        }
+
+        BasicImage& operator-=(const BasicImage& other) {
+            checkShape(other, "operator-=");
+            cv::Mat dst = mat();
+            cv::subtract(dst, other.mat(), dst);
+            return *this;
+        }
+
+        BasicImage& operator*=(double factor) {
+            cv::Mat dst = mat();
+            dst.convertTo(dst, -1, factor);
+            return *this;
+        }
+
+        /**
+         * @brief Adds an 8-bit frame without converting it first, for running sums over many frames.
+         */
+        BasicImage& accumulate(const Image& frame) {
+            if (!frame.isValid() || frame.width != width_ || frame.height != height_ || frame.channels != channels_)
+                throw std::invalid_argument("[BasicImage::accumulate] Frame does not match the image size");
+
+            cv::Mat dst = mat();
+            cv::add(dst, imageMat(frame), dst, cv::noArray(), Depth);
+            return *this;
+        }
+
+        /**
+         * @brief |a - b| per channel into `out`, which is (re)sized only when its shape differs.
+         */
+        static void absdiff(const BasicImage& a, const BasicImage& b, BasicImage& out) {
+            a.checkShape(b, "absdiff");
+            if (!out.sameShape(a)) out = BasicImage(a.width_, a.height_, a.channels_);
+
+            cv::Mat dst = out.mat();
+            cv::absdiff(a.mat(), b.mat(), dst);
+        }
+
+        [[nodiscard]] static BasicImage absdiff(const BasicImage& a, const BasicImage& b) {
+            BasicImage out;
+            absdiff(a, b, out);
+            return out;
+        }
+
+        friend BasicImage operator+(BasicImage a, const BasicImage& b) { return a += b; }
+        friend BasicImage operator-(BasicImage a, const BasicImage& b) { return a -= b; }
+        friend BasicImage operator*(BasicImage a, double factor) { return a *= factor; }
+
+    private:
+        int width_ = 0;
+        int height_ = 0;
+        int channels_ = 0;
+        std::vector<T> pixels_;
+
+        [[nodiscard]] size_t count() const {
+            return static_cast<size_t>(width_) * height_ * channels_;
+        }
+
+        static void checkSize(int width, int height, int channels, const char* caller) {
+            if (width < 0 || height < 0 || channels < 1 || channels > 4)
+                throw std::invalid_argument(std::string("[BasicImage::") + caller + "] Invalid size or channel count");
+        }
+
+        void checkShape(const BasicImage& other, const char* caller) const {
+            if (!sameShape(other))
+                throw std::invalid_argument(std::string("[BasicImage::") + caller + "] Images differ in size or channels");
+        }
+
+        // Storage-order header over the rows of an 8-bit image, honouring its stride.
+        static cv::Mat imageMat(const Image& image) {
+            return cv::Mat(image.height, image.width, CV_8UC(image.channels),
+                           const_cast<uint8_t*>(image.rowPtr(0)), image.rowStride());
+        }
+    };
+
+    using ImageU8 = BasicImage<uint8_t>;
+    using ImageU16 = BasicImage<uint16_t>;
+    using ImageF32 = BasicImage<float>;
+}
@@ -1,64 +1,365 @@
 #pragma once
 
 #include "LibGraphics/type/Rect.hpp"
+#include "LibGraphics/type/PixelBuffer.hpp"
+#include "LibGraphics/memory/PixelAllocator.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <filesystem>
 #include <array>
+#include <stdexcept>
 
 
 #include <opencv2/core.hpp>
 
 #include "export.hpp"
+#include "ImageView.hpp"
+#include "PixelRow.hpp"
+#include "IntegralImage.hpp"
+#include "LoadOptions.hpp"
+#include "RedactOptions.hpp"
 
 using LibGraphics::Type::Rect;
+using LibGraphics::Type::PixelBuffer;
 
 namespace LibGraphics {
 
+    namespace Detail {
+        struct ImageCache;
+    }
+
+    /**
+     * @brief 8-bit interleaved image.
+     *
+     * Copying an Image is cheap: the pixels (and the cached cv::Mat
+     * representations) are shared until one of the copies is mutated.
+     *
+     * Thread safety: any number of threads may call const members on the same
+     * Image at once, including the first mat()/matGray() call that builds the
+     * cache; the build runs exactly once and the others wait for it. Copies
+     * that share pixels behave like separate objects and may be used (and
+     * mutated) from different threads. Mutating one Image object (non-const
+     * calls, assigning fields) while other threads read that same object is
+     * a data race, as for any standard container.
+     */
     struct LIBGRAPHICS_API Image {
-        std::vector<uint8_t> data;
+        PixelBuffer data;
         int width = 0;
         int height = 0;
         int channels = 0;
+        size_t stride = 0;  // Bytes from one row to the next; 0 means packed (width * channels)
         std::string origin = "empty";
 
+        // Row alignment of aligned() images; matches what every PixelAllocator hands out.
+        static constexpr size_t RowAlignment = Memory::PixelAllocator::Alignment;
+
         Image() = default;
-        Image(int width, int height, int channels, std::vector<uint8_t> pixels);
+        Image(int width, int height, int channels, PixelBuffer pixels);
+
+        /**
+         * @brief Image over rows that are `stride` bytes apart (0 for packed).
+         *
+         * `pixels` must hold exactly stride * height bytes; the padding after
+         * each row is never read.
+         */
+        Image(int width, int height, int channels, PixelBuffer pixels, size_t stride);
+
+        /**
+         * @brief Uninitialized image; with `alignRows` every row starts on a RowAlignment boundary.
+         */
+        static Image allocate(int width, int height, int channels, bool alignRows = false);
+
+        /**
+         * @brief Smallest stride of at least width * channels that is a multiple of RowAlignment.
+         */
+        [[nodiscard]] static size_t alignedStride(int width, int channels);
+
+        [[nodiscard]] size_t rowStride() const { return stride != 0 ? stride : static_cast<size_t>(width) * channels; }
+        [[nodiscard]] bool isPacked() const { return rowStride() == static_cast<size_t>(width) * channels; }
+
+        /**
+         * @brief Row `y`; with an aligned stride every row pointer is RowAlignment aligned.
+         *
+         * The non-const overload detaches shared pixels first, like data.data().
+         */
+        [[nodiscard]] const uint8_t* rowPtr(int y) const { return data.constData() + static_cast<size_t>(y) * rowStride(); }
+        [[nodiscard]] uint8_t* rowPtr(int y) { return data.data() + static_cast<size_t>(y) * rowStride(); }
+
+        /**
+         * @brief Same pixels with every row padded to RowAlignment.
+         *
+         * Returns a copy sharing the pixels when the layout already is aligned.
+         * Images derived from an aligned image (crop, resize, toGrayscale,
+         * pyramid levels) are aligned as well, so SIMD code can use aligned
+         * loads on every row without head handling.
+         */
+        [[nodiscard]] Image aligned() const;
 
-        static Image load(const std::string& path);
-        static Image load_from_memory(const uint8_t* buffer, size_t size);
-        static Image load_from_memory(const std::vector<uint8_t>& buffer);
+        /**
+         * @brief Same pixels without row padding, sharing them when already packed.
+         */
+        [[nodiscard]] Image packed() const;
 
+        static Image load(const std::string& path, const LoadOptions& options = LoadOptions());
+        static Image load_from_memory(const uint8_t* buffer, size_t size, const LoadOptions& options = LoadOptions());
+        static Image load_from_memory(const std::vector<uint8_t>& buffer, const LoadOptions& options = LoadOptions());
+
+        using EncodeCallback = std::function<void(const uint8_t* bytes, size_t size)>;
+
+        /**
+         * @brief Encodes in the format named by the extension (PNG otherwise) and writes `path`.
+         *
+         * The file is only opened once encoding succeeded, so a failure leaves
+         * an existing file as it was.
+         */
         [[nodiscard]] bool save(const std::string& path, int quality = 90) const;
+
+        /**
+         * @brief Encodes to memory, the counterpart of load_from_memory().
+         *
+         * `format` is "png", "jpg"/"jpeg", "bmp" or "tga" (case-insensitive, a
+         * leading dot is fine); anything else throws std::invalid_argument.
+         * `quality` only applies to JPEG. Returns an empty vector when the
+         * image is invalid or encoding fails.
+         */
+        [[nodiscard]] std::vector<uint8_t> encode(const std::string& format, int quality = 90) const;
+
+        /**
+         * @brief Streams the encoded bytes to `sink` as they are produced.
+         *
+         * The sink may be called many times; chunks arrive in order. Use this to
+         * write into your own buffer or upload stream without an extra copy.
+         */
+        bool encode(const std::string& format, const EncodeCallback& sink, int quality = 90) const;
+
+        /**
+         * @brief zlib level (0-9) used for PNG output by save() and encode(), process-wide.
+         *
+         * Lower is faster and bigger. Defaults to 8. With LIBGRAPHICS_WITH_SPNG
+         * PNG is written by libspng, otherwise by stb_image_write. Meant to be
+         * set once at startup, not while other threads are saving.
+         */
+        static void setPngCompressionLevel(int level);
+        [[nodiscard]] static int pngCompressionLevel();
         void show() const;
 
+        /**
+         * @brief Rec.601 luma (0.299 R + 0.587 G + 0.114 B) in 15-bit fixed point, rounded.
+         *
+         * Uses the widest SIMD path the CPU offers (SSE4.1, AVX2, AVX-512BW or NEON);
+         * every path produces the same bytes.
+         */
         [[nodiscard]] Image toGrayscale() const;
         [[nodiscard]] Image crop(int x, int y, int width, int height) const;
+
+        /**
+         * @brief Non-owning view of the whole image, or of a sub-rectangle in O(1).
+         *
+         * The view points into `data`; it is invalidated by anything that
+         * reallocates or detaches the pixel buffer.
+         */
+        [[nodiscard]] ImageView view() const { return ImageView(*this); }
+        [[nodiscard]] ImageView view(int x, int y, int width, int height) const { return view().crop(x, y, width, height); }
         [[nodiscard]] Image resize(int newWidth, int newHeight) const;
+
+        /**
+         * @brief Level `level` of the image pyramid; level 0 is the image itself.
+         *
+         * Every level is half the size of the one before it, rounded up, and
+         * downscaled from it with INTER_AREA. Level n has the size load() gives
+         * with LoadOptions().scale(1 << n), but not its pixels: the decoder
+         * resizes once (and JPEG scales in the DCT), while the pyramid halves
+         * n times, so values can differ slightly. Levels are built on
+         * first use and cached with the pixels: copies that share pixels share
+         * the levels, and the levels are dropped as soon as the pixels change.
+         * The returned images share their pixels with the cache. Safe to call
+         * from several threads at once. Throws std::invalid_argument for a
+         * negative level.
+         */
+        [[nodiscard]] Image pyramidLevel(int level) const;
+
+        /**
+         * @brief Levels 0 to `levels` - 1, stopping early once a level is 1x1.
+         */
+        [[nodiscard]] std::vector<Image> pyramid(int levels) const;
+        /**
+         * @brief Returns a copy that shares the pixel buffer until either side writes.
+         */
         [[nodiscard]] Image clone() const;
 
+        /**
+         * @brief Summed-area tables of every channel (R, G, B order), built on first use.
+         *
+         * Gives O(1) sums, means and variances over any Rect. Cached with the
+         * pixels like mat(); markDirty() (so also redact()) drops the tables
+         * and the next call rebuilds them. The returned object stays valid
+         * after that, it just describes the old pixels.
+         *
+         * The two CV_64F tables take 16 bytes per channel value, about 16 times
+         * the pixel data, and stay with the image until it changes or goes
+         * away. Worth it for many queries on one frame; for a few sums over a
+         * small area run cv::integral on that area instead.
+         */
+        [[nodiscard]] IntegralImage integral() const;
+
+        /**
+         * @brief Summed-area tables of matGray(), cached like integral() and as large per value.
+         */
+        [[nodiscard]] IntegralImage integralGray() const;
+
+        /**
+         * @brief Checked single pixel read; for loops over many pixels use row() or forEachPixel().
+         */
         [[nodiscard]] std::array<uint8_t, 3> getRGB(int x, int y) const;
         [[nodiscard]] bool isValid() const;
 
+        /**
+         * @brief Row `y` as a span of pixels, without any checks.
+         *
+         * `y` must be in [0, height) of a valid image. The non-const overload
+         * detaches shared pixels like rowPtr(); writes through it need a
+         * markDirty() call, or use modifyRows()/modifyPixels() which do that.
+         */
+        [[nodiscard]] ConstPixelRow row(int y) const { return {rowPtr(y), width, channels}; }
+        [[nodiscard]] PixelRow row(int y) { return {rowPtr(y), width, channels}; }
+
+        /**
+         * @brief Calls `fn(y, ConstPixelRow)` for every row, spread over OpenCV's thread pool.
+         *
+         * The image is checked once, then rows are handed out in parallel in no
+         * particular order: `fn` must be safe to call from several threads at
+         * once and must not throw. Throws std::runtime_error for an invalid image.
+         */
+        template <typename Fn>
+        void forEachRow(Fn&& fn) const {
+            if (!isValid())
+                throw std::runtime_error("[Image::forEachRow] Invalid image");
+
+            cv::parallel_for_(cv::Range(0, height), [&](const cv::Range& rows) {
+                for (int y = rows.start; y < rows.end; ++y) fn(y, row(y));
+            });
+        }
+
+        /**
+         * @brief Calls `fn(x, y, ConstPixelRef)` for every pixel, rows in parallel as in forEachRow().
+         */
+        template <typename Fn>
+        void forEachPixel(Fn&& fn) const {
+            forEachRow([&](int y, ConstPixelRow pixels) {
+                for (int x = 0; x < pixels.width(); ++x) fn(x, y, pixels[x]);
+            });
+        }
+
+        /**
+         * @brief forEachRow() with writable rows; the caches are brought up to date afterwards.
+         */
+        template <typename Fn>
+        void modifyRows(Fn&& fn) {
+            if (!isValid())
+                throw std::runtime_error("[Image::modifyRows] Invalid image");
+
+            // Detach once up front so the workers never race on a shared buffer.
+            uint8_t* base = data.data();
+            const size_t step = rowStride();
+
+            cv::parallel_for_(cv::Range(0, height), [&](const cv::Range& rows) {
+                for (int y = rows.start; y < rows.end; ++y)
+                    fn(y, PixelRow(base + static_cast<size_t>(y) * step, width, channels));
+            });
+
+            markDirty(Rect{0, 0, width, height});
+        }
+
+        /**
+         * @brief forEachPixel() with writable pixels (PixelRef), see modifyRows().
+         */
+        template <typename Fn>
+        void modifyPixels(Fn&& fn) {
+            modifyRows([&](int y, PixelRow pixels) {
+                for (int x = 0; x < pixels.width(); ++x) fn(x, y, pixels[x]);
+            });
+        }
+
         explicit operator bool() const { return isValid(); }
 
+        /**
+         * @brief Allocator for the pixel buffers of every Image created afterwards.
+         *
+         * Pass Memory::BufferPool::shared() to recycle frame buffers instead of
+         * going to malloc for each decode/gray/crop/resize, or nullptr to go back
+         * to the plain heap.
+         */
+        static void setAllocator(std::shared_ptr<Memory::PixelAllocator> allocator);
+        [[nodiscard]] static std::shared_ptr<Memory::PixelAllocator> allocator();
+
         void redact(const Rect& roi, uint8_t value = 0);
         void redact(const std::vector<Rect>& rois, uint8_t value = 0);
 
-        cv::Mat& mat();             // kleur
+        /**
+         * @brief Redacts every rectangle in one pass.
+         *
+         * The rectangles are clipped and merged into per-row spans first, so
+         * overlaps are painted once and solid fills become plain memset/memcpy
+         * runs. Throws std::invalid_argument when blockSize or radius is out of range.
+         */
+        void redact(const Rect& roi, const RedactOptions& options);
+        void redact(const std::vector<Rect>& rois, const RedactOptions& options);
+
+        /**
+         * @brief Non-owning cv::Mat header over `data` (no pixel copy).
+         *
+         * Writes through the returned Mat modify the image itself; the non-const
+         * overload detaches shared pixels first, the const overload never copies
+         * and must not be written through. The header is rebuilt automatically
+         * when `data` has been reallocated or the dimensions changed, so never
+         * keep it across calls that resize or replace `data`.
+         */
+        cv::Mat& mat();
         const cv::Mat& mat() const;
 
-        cv::Mat& matGray();         // zwart-wit
+        /**
+         * @brief Grayscale plane of the image, built on first use.
+         *
+         * For single channel images this is the same view as mat(). Otherwise it is
+         * a derived buffer; redact() patches it in place, direct writes into `data`
+         * need a markDirty() call.
+         */
+        cv::Mat& matGray();
         const cv::Mat& matGray() const;
 
+        /**
+         * @brief One channel (0 = R, 1 = G, 2 = B) as its own contiguous 8-bit plane.
+         *
+         * The first call splits every channel in one pass and caches the planes
+         * like matGray(), so per-channel scans and statistics read consecutive
+         * bytes instead of every third one. redact() patches the planes in
+         * place, direct writes into `data` need a markDirty() call. Single
+         * channel images return mat(). Throws std::out_of_range for a channel
+         * the image does not have.
+         */
+        const cv::Mat& plane(int channel) const;
+
+        /**
+         * @brief Brings the derived caches up to date after pixels inside `rect` changed in place.
+         *
+         * Only the cached representations that were already built are touched,
+         * and only inside `rect` (clipped to the image), so small edits on a big
+         * frame stay cheap. Pyramid levels and integral tables are dropped and
+         * rebuilt on next use. Mutators of Image call this themselves; call it after
+         * writing through `data` or mat() yourself.
+         */
+        void markDirty(const Rect& rect);
+
     private:
-        mutable cv::Mat cachedColor;
-        mutable cv::Mat cachedGray;
+        std::shared_ptr<Detail::ImageCache> cacheFor() const;
+        std::shared_ptr<Detail::ImageCache> findCache(const std::shared_ptr<void>& head) const;
+        static void stripAlpha(PixelBuffer& pixels, int width, int height, int& channels);
+        static Image decode(const uint8_t* bytes, size_t size, const LoadOptions& options);
 
-        void invalidateCache() const;
-        static void stripAlpha(std::vector<uint8_t>& pixels, int width, int height, int& channels);
+        static void copyRows(const Image& src, Image& dst);
 
         static std::string mkTempFilename(
             const std::string& prefix = "libgraphics_",
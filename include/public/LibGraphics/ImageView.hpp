@@ -0,0 +1,64 @@
+#pragma once
+
+#include "export.hpp"
+#include "PixelRow.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <opencv2/core.hpp>
+
+namespace LibGraphics {
+
+    struct Image;
+
+    /**
+     * @brief Non-owning window onto 8-bit interleaved pixels.
+     *
+     * A view is a pointer plus geometry; it never copies or frees pixels, so the
+     * image it was taken from must outlive it and must not be reallocated while
+     * the view is in use. Rows are `stride` bytes apart, which lets crop() narrow
+     * a view in O(1).
+     */
+    struct LIBGRAPHICS_API ImageView {
+        const uint8_t* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        size_t stride = 0;
+
+        ImageView() = default;
+        ImageView(const uint8_t* pixels, int width, int height, int channels, size_t stride = 0);
+        ImageView(const Image& image);
+
+        [[nodiscard]] bool isValid() const;
+        explicit operator bool() const { return isValid(); }
+
+        [[nodiscard]] const uint8_t* rowPtr(int y) const { return pixels + static_cast<size_t>(y) * stride; }
+
+        /**
+         * @brief Row `y` as a span of pixels; `y` is not checked, see Image::row().
+         */
+        [[nodiscard]] ConstPixelRow row(int y) const { return {rowPtr(y), width, channels}; }
+
+        /**
+         * @brief Narrows the view to a sub-rectangle without touching any pixels.
+         * @return An empty view when the rectangle is not fully inside this view.
+         */
+        [[nodiscard]] ImageView crop(int x, int y, int width, int height) const;
+
+        [[nodiscard]] std::array<uint8_t, 3> getRGB(int x, int y) const;
+
+        /**
+         * @brief cv::Mat header over the viewed pixels (no copy). Do not write through it.
+         */
+        [[nodiscard]] cv::Mat mat() const;
+
+        /**
+         * @brief Copies the viewed pixels into a tightly packed Image, or one
+         * with rows padded to Image::RowAlignment when `alignRows` is set.
+         */
+        [[nodiscard]] Image toImage(bool alignRows = false) const;
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "LibGraphics/type/Rect.hpp"
+#include "export.hpp"
+
+#include <opencv2/core.hpp>
+
+using LibGraphics::Type::Rect;
+
+namespace LibGraphics {
+
+    /**
+     * @brief Summed-area tables of an image: sums over any rectangle in O(1).
+     *
+     * Holds the (height + 1) x (width + 1) CV_64F tables cv::integral produces
+     * for the pixel values and for their squares, one table channel per image
+     * channel, in the image's own channel order (R, G, B for colour images).
+     * Get one from Image::integral() or Image::integralGray(), which build it
+     * once and cache it with the pixels. Copies share the tables.
+     *
+     * Rectangles are clipped to the image; one that falls outside entirely sums
+     * to 0 and has a mean and variance of 0. A channel out of range throws
+     * std::out_of_range.
+     */
+    class LIBGRAPHICS_API IntegralImage {
+    public:
+        IntegralImage() = default;
+        IntegralImage(cv::Mat sum, cv::Mat squaredSum);
+
+        [[nodiscard]] bool isValid() const { return !sum_.empty(); }
+        explicit operator bool() const { return isValid(); }
+
+        [[nodiscard]] int width() const { return sum_.empty() ? 0 : sum_.cols - 1; }
+        [[nodiscard]] int height() const { return sum_.empty() ? 0 : sum_.rows - 1; }
+        [[nodiscard]] int channels() const { return sum_.channels(); }
+
+        /**
+         * @brief The raw tables, e.g. to hand to OpenCV.
+         */
+        [[nodiscard]] const cv::Mat& sumTable() const { return sum_; }
+        [[nodiscard]] const cv::Mat& squaredSumTable() const { return squaredSum_; }
+
+        [[nodiscard]] double sum(const Rect& rect, int channel = 0) const;
+        [[nodiscard]] double squaredSum(const Rect& rect, int channel = 0) const;
+        [[nodiscard]] double mean(const Rect& rect, int channel = 0) const;
+
+        /**
+         * @brief Population variance (divided by the pixel count) of the clipped rectangle.
+         */
+        [[nodiscard]] double variance(const Rect& rect, int channel = 0) const;
+        [[nodiscard]] double stddev(const Rect& rect, int channel = 0) const;
+
+    private:
+        cv::Mat sum_;
+        cv::Mat squaredSum_;
+
+        [[nodiscard]] Rect clip(const Rect& rect, int channel, const char* caller) const;
+        [[nodiscard]] static double boxSum(const cv::Mat& table, const Rect& clipped, int channel);
+    };
+}
@@ -6,6 +6,7 @@
 #include "color/BackgroundScanner.hpp"
 #include "color/Information.hpp"
 #include "match/TemplateMatcher.hpp"
+#include "match/PreparedTemplate.hpp"
 #include "color/BackgroundScanner.hpp"
 
 #include "ocr/OcrTextReader.hpp"
@@ -14,6 +15,12 @@
 #include "exceptions/LowConfidenceException.hpp"
 #include "match/TemplateMatcher.hpp"
 #include "Image.hpp"
+#include "BasicImage.hpp"
+#include "ImageView.hpp"
+#include "PixelRow.hpp"
+#include "IntegralImage.hpp"
+#include "LoadOptions.hpp"
+#include "RedactOptions.hpp"
 
 namespace LibGraphics {
     struct OpenCVInfo {
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "export.hpp"
+
+namespace LibGraphics {
+
+    /**
+     * @brief How Image::load / load_from_memory should decode.
+     *
+     * With the libjpeg-turbo backend (LIBGRAPHICS_WITH_TURBOJPEG) both options
+     * are applied inside the JPEG decoder: scaling happens in the DCT domain
+     * and grayscale decodes only the luma plane, so most of the work is
+     * skipped. Other formats, or builds without turbo, decode at full size and
+     * then downscale (INTER_AREA) and/or convert with toGrayscale(), which
+     * yields the same dimensions and channel count. Row padding is likewise
+     * written by the JPEG decoder directly and applied with Image::aligned()
+     * otherwise.
+     */
+    struct LIBGRAPHICS_API LoadOptions {
+        int scaleDenominator = 1;  // Decode at 1/1, 1/2, 1/4 or 1/8 of the stored size (rounded up)
+        bool grayscale = false;    // Decode to a single luma channel
+        bool alignRows = false;    // Pad rows to Image::RowAlignment, see Image::aligned()
+
+        LoadOptions() = default;
+
+        LoadOptions& scale(int denominator) {
+            scaleDenominator = denominator;
+            return *this;
+        }
+
+        LoadOptions& gray(bool enabled = true) {
+            grayscale = enabled;
+            return *this;
+        }
+
+        LoadOptions& aligned(bool enabled = true) {
+            alignRows = enabled;
+            return *this;
+        }
+    };
+}
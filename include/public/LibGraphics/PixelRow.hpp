@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace LibGraphics {
+
+    /**
+     * @brief One interleaved 8-bit pixel: `channels` bytes starting at data().
+     *
+     * `Byte` is `uint8_t` for writable pixels and `const uint8_t` for read-only
+     * ones. Nothing is checked; the pixel comes from a row that was.
+     */
+    template <typename Byte>
+    class BasicPixelRef {
+    public:
+        BasicPixelRef(Byte* data, int channels) : data_(data), channels_(channels) {}
+
+        // Writable pixels convert to read-only ones.
+        template <typename Other, typename = std::enable_if_t<std::is_const_v<Byte> && !std::is_const_v<Other>>>
+        BasicPixelRef(const BasicPixelRef<Other>& other) : data_(other.data()), channels_(other.channels()) {}
+
+        [[nodiscard]] Byte* data() const { return data_; }
+        [[nodiscard]] int channels() const { return channels_; }
+
+        Byte& operator[](int channel) const { return data_[channel]; }
+
+        /**
+         * @brief Same result as Image::getRGB(): gray (and gray + alpha) repeats the gray value.
+         */
+        [[nodiscard]] std::array<uint8_t, 3> rgb() const {
+            if (channels_ < 3) return {data_[0], data_[0], data_[0]};
+            return {data_[0], data_[1], data_[2]};
+        }
+
+        /**
+         * @brief The alpha byte of gray + alpha and RGBA pixels, 255 for the others.
+         */
+        [[nodiscard]] uint8_t alpha() const {
+            return channels_ == 2 || channels_ == 4 ? data_[channels_ - 1] : 255;
+        }
+
+    private:
+        Byte* data_;
+        int channels_;
+    };
+
+    /**
+     * @brief Random access iterator over the pixels of a row; dereferences to a BasicPixelRef.
+     */
+    template <typename Byte>
+    class BasicPixelIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = BasicPixelRef<Byte>;
+        using difference_type = std::ptrdiff_t;
+        using reference = BasicPixelRef<Byte>;
+        using pointer = void;
+
+        BasicPixelIterator() = default;
+        BasicPixelIterator(Byte* data, int channels) : data_(data), channels_(channels) {}
+
+        reference operator*() const { return {data_, channels_}; }
+        reference operator[](difference_type n) const { return {data_ + n * channels_, channels_}; }
+
+        BasicPixelIterator& operator++() { data_ += channels_; return *this; }
+        BasicPixelIterator operator++(int) { BasicPixelIterator old = *this; ++*this; return old; }
+        BasicPixelIterator& operator--() { data_ -= channels_; return *this; }
+        BasicPixelIterator operator--(int) { BasicPixelIterator old = *this; --*this; return old; }
+
+        BasicPixelIterator& operator+=(difference_type n) { data_ += n * channels_; return *this; }
+        BasicPixelIterator& operator-=(difference_type n) { data_ -= n * channels_; return *this; }
+
+        friend BasicPixelIterator operator+(BasicPixelIterator it, difference_type n) { return it += n; }
+        friend BasicPixelIterator operator+(difference_type n, BasicPixelIterator it) { return it += n; }
+        friend BasicPixelIterator operator-(BasicPixelIterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const BasicPixelIterator& a, const BasicPixelIterator& b) {
+            return (a.data_ - b.data_) / a.channels_;
+        }
+
+        friend bool operator==(const BasicPixelIterator& a, const BasicPixelIterator& b) { return a.data_ == b.data_; }
+        friend bool operator!=(const BasicPixelIterator& a, const BasicPixelIterator& b) { return a.data_ != b.data_; }
+        friend bool operator<(const BasicPixelIterator& a, const BasicPixelIterator& b) { return a.data_ < b.data_; }
+        friend bool operator>(const BasicPixelIterator& a, const BasicPixelIterator& b) { return a.data_ > b.data_; }
+        friend bool operator<=(const BasicPixelIterator& a, const BasicPixelIterator& b) { return a.data_ <= b.data_; }
+        friend bool operator>=(const BasicPixelIterator& a, const BasicPixelIterator& b) { return a.data_ >= b.data_; }
+
+    private:
+        Byte* data_ = nullptr;
+        int channels_ = 1;
+    };
+
+    /**
+     * @brief Span over one row of interleaved 8-bit pixels, from Image::row() or ImageView::row().
+     *
+     * A pointer, a width and a channel count; indexing and iteration do no
+     * checks at all, so a loop over a row costs the same as one over a raw
+     * pointer. Like ImageView it does not own the pixels.
+     */
+    template <typename Byte>
+    class BasicPixelRow {
+    public:
+        using iterator = BasicPixelIterator<Byte>;
+
+        BasicPixelRow() = default;
+        BasicPixelRow(Byte* data, int width, int channels) : data_(data), width_(width), channels_(channels) {}
+
+        template <typename Other, typename = std::enable_if_t<std::is_const_v<Byte> && !std::is_const_v<Other>>>
+        BasicPixelRow(const BasicPixelRow<Other>& other) : data_(other.data()), width_(other.width()), channels_(other.channels()) {}
+
+        [[nodiscard]] Byte* data() const { return data_; }
+        [[nodiscard]] int width() const { return width_; }
+        [[nodiscard]] int size() const { return width_; }
+        [[nodiscard]] bool empty() const { return width_ == 0; }
+        [[nodiscard]] int channels() const { return channels_; }
+        [[nodiscard]] size_t byteSize() const { return static_cast<size_t>(width_) * channels_; }
+
+        BasicPixelRef<Byte> operator[](int x) const { return {data_ + static_cast<size_t>(x) * channels_, channels_}; }
+
+        [[nodiscard]] iterator begin() const { return {data_, channels_}; }
+        [[nodiscard]] iterator end() const { return {data_ + byteSize(), channels_}; }
+
+    private:
+        Byte* data_ = nullptr;
+        int width_ = 0;
+        int channels_ = 1;
+    };
+
+    using PixelRef = BasicPixelRef<uint8_t>;
+    using ConstPixelRef = BasicPixelRef<const uint8_t>;
+    using PixelRow = BasicPixelRow<uint8_t>;
+    using ConstPixelRow = BasicPixelRow<const uint8_t>;
+}
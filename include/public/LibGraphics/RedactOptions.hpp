@@ -0,0 +1,53 @@
+#pragma once
+
+#include "export.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace LibGraphics {
+
+    /**
+     * @brief How Image::redact fills the rectangles it is given.
+     *
+     * Rectangles are merged first, so overlapping ones are painted once and
+     * pixelate/blur never sample pixels that were already redacted. The alpha
+     * channel of 4-channel images is left alone.
+     */
+    struct LIBGRAPHICS_API RedactOptions {
+        enum class Fill {
+            Solid,     // Paint `color`
+            Pixelate,  // Mean of each blockSize x blockSize cell, cells aligned to the image origin
+            Blur       // Box blur of the given radius, sampling the original pixels
+        };
+
+        Fill fill = Fill::Solid;
+        std::array<uint8_t, 3> color{0, 0, 0};  // RGB; single channel images get its luma
+        int blockSize = 16;                     // Pixelate, 1-4096
+        int radius = 8;                         // Blur, 1-2048
+
+        RedactOptions() = default;
+
+        RedactOptions& solid(uint8_t value) {
+            return solid(value, value, value);
+        }
+
+        RedactOptions& solid(uint8_t r, uint8_t g, uint8_t b) {
+            fill = Fill::Solid;
+            color = {r, g, b};
+            return *this;
+        }
+
+        RedactOptions& pixelate(int block = 16) {
+            fill = Fill::Pixelate;
+            blockSize = block;
+            return *this;
+        }
+
+        RedactOptions& blur(int boxRadius = 8) {
+            fill = Fill::Blur;
+            radius = boxRadius;
+            return *this;
+        }
+    };
+}
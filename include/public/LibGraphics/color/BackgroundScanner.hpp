@@ -5,6 +5,7 @@
 #include <vector>
 #include <cstdint>
 #include <LibGraphics/Image.hpp>
+#include <LibGraphics/ImageView.hpp>
 
 namespace LibGraphics::Color {
     class LIBGRAPHICS_API BackgroundScanner {
@@ -36,12 +37,41 @@ namespace LibGraphics::Color {
                                           bool debug = false);
 
 
-        static int background_color_change_up(const Image& img,
+        static int background_color_change_up(const ImageView& img,
                                       int start_x = 0,
                                       int start_y = 600,
                                       int max_attempts = 600,
                                       bool debug = false);
 
+        static int background_color_change_down(const ImageView& img,
+                                                int start_x = 0,
+                                                int start_y = 0,
+                                                int max_attempts = 600,
+                                                bool debug = false);
+
+        static int background_color_change_left(const ImageView& img,
+                                                int start_x = 0,
+                                                int start_y = 600,
+                                                int max_attempts = 600,
+                                                bool debug = false);
+
+        static int background_color_change_right(const ImageView& img,
+                                                 int start_x = 0,
+                                                 int start_y = 600,
+                                                 int max_attempts = 600,
+                                                 bool debug = false);
+
+
+        /*
+         * Image and ImageView overloads read the red (or gray) channel straight
+         * from the pixels, without copying or caching anything.
+         */
+        static int background_color_change_up(const Image& img,
+                                              int start_x = 0,
+                                              int start_y = 600,
+                                              int max_attempts = 600,
+                                              bool debug = false);
+
         static int background_color_change_down(const Image& img,
                                                 int start_x = 0,
                                                 int start_y = 0,
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "LibGraphics/export.hpp"
+#include "LibGraphics/Image.hpp"
+
+#include <opencv2/core.hpp>
 
 namespace LibGraphics::Color {
     class LIBGRAPHICS_API Information {
@@ -26,5 +29,22 @@ namespace LibGraphics::Color {
          * @return true if all RGB components are above the threshold
          */
         static bool is_white(int r, int g, int b, int threshold = 220);
+
+        /**
+         * @brief is_greenish() for every pixel at once.
+         *
+         * Works on the cached channel planes (Image::plane), so the checks run as
+         * contiguous per-channel passes instead of a loop over interleaved pixels.
+         *
+         * @return CV_8U mask of the image size, 255 where the pixel is greenish
+         */
+        static cv::Mat greenish_mask(const Image& image, int buffer = 25);
+
+        /**
+         * @brief is_white() for every pixel at once, see greenish_mask().
+         *
+         * @return CV_8U mask of the image size, 255 where the pixel is white
+         */
+        static cv::Mat white_mask(const Image& image, int threshold = 220);
     };
 }
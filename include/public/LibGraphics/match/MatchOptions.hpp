@@ -1,13 +1,37 @@
 #pragma once
 
 #include "LibGraphics/export.hpp"
+#include "LibGraphics/type/Rect.hpp"
 #include <opencv2/imgproc.hpp>
 
+#include <vector>
+
 namespace LibGraphics::Match {
     struct LIBGRAPHICS_API MatchOptions {
         double minConfidence = 0.0;  // Minimum confidence threshold (0.0 to 1.0)
         bool grayscale = false;
 
+        // Coarse-to-fine search for matchTemplateSingle: match at pyramid level
+        // `pyramidLevels` (each level halves the size, fewer when the template
+        // would drop under 8 px), then rescore the `pyramidCandidates` best
+        // coarse peaks in small full-resolution windows. Scores and locations
+        // are full-resolution ones. 0 searches the full target.
+        int pyramidLevels = 0;
+        int pyramidCandidates = 4;
+
+        // Parts of the target to search, in target coordinates, instead of the
+        // whole target. Each one is searched in place (no copy) and clipped to
+        // the target; results stay in full-frame coordinates. Regions smaller
+        // than the template are skipped.
+        std::vector<Type::Rect> searchRegions;
+
+        // Match large targets in overlapping tiles of about tileSize x tileSize
+        // pixels (at least twice the template), spread over the cores, so each
+        // result map stays tile sized. Peaks are merged into the same results
+        // as an untiled search. 0 matches every region in one piece; the
+        // pyramid mode only tiles its fallback full search.
+        int tileSize = 0;
+
         MatchOptions() = default;
 
         explicit MatchOptions(double minConf)
@@ -19,6 +43,25 @@ namespace LibGraphics::Match {
             return *this;
         }
 
+        // Enable the coarse-to-fine search (builder pattern)
+        MatchOptions& pyramid(int levels, int candidates = 4) {
+            pyramidLevels = levels;
+            pyramidCandidates = candidates;
+            return *this;
+        }
+
+        // Add a search region (builder pattern)
+        MatchOptions& region(const Type::Rect& roi) {
+            searchRegions.push_back(roi);
+            return *this;
+        }
+
+        // Enable tiled matching (builder pattern)
+        MatchOptions& tiled(int size) {
+            tileSize = size;
+            return *this;
+        }
+
         // Get the matching method
         int getMethod() const { return matchMethod_; }
 
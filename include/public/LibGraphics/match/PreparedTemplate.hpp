@@ -0,0 +1,57 @@
+#pragma once
+
+#include "LibGraphics/Image.hpp"
+#include "LibGraphics/export.hpp"
+#include "LibGraphics/match/MatchOptions.hpp"
+
+#include <memory>
+
+namespace LibGraphics::Match {
+
+    namespace Detail {
+        class TemplateState;
+    }
+
+    /**
+     * @brief A template with its side of the matching work done once, for matching against many targets.
+     *
+     * Keeps the template converted to the format the matcher needs (colour,
+     * colour without alpha, or gray), with its mean and norm. Each format is
+     * built on first use and reused by every later match. Template spectra are
+     * sized by the target, so they only live for one matching call: reused
+     * across its regions and tiles, then freed, which keeps a large icon set
+     * at the size of its pixels.
+     *
+     * The TemplateMatcher overloads taking a PreparedTemplate use the options
+     * given here, read the way the Image overloads read them. Copies share the
+     * caches and may be used from several threads at once.
+     */
+    class LIBGRAPHICS_API PreparedTemplate {
+    public:
+        PreparedTemplate() = default;
+
+        /**
+         * @brief Throws std::invalid_argument for an invalid image.
+         */
+        explicit PreparedTemplate(const Image& image, const MatchOptions& options = MatchOptions());
+
+        [[nodiscard]] bool isValid() const { return state_ != nullptr; }
+        explicit operator bool() const { return isValid(); }
+
+        [[nodiscard]] int width() const;
+        [[nodiscard]] int height() const;
+        [[nodiscard]] const Image& image() const;
+        [[nodiscard]] const MatchOptions& options() const { return options_; }
+
+        /**
+         * @brief The same template and caches with other options, e.g. another threshold.
+         */
+        [[nodiscard]] PreparedTemplate withOptions(const MatchOptions& options) const;
+
+    private:
+        friend class TemplateMatcher;
+
+        std::shared_ptr<const Detail::TemplateState> state_;
+        MatchOptions options_;
+    };
+}
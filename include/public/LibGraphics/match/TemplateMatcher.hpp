@@ -1,9 +1,14 @@
 #pragma once
 
 #include "LibGraphics/Image.hpp"
+#include "LibGraphics/ImageView.hpp"
 #include "LibGraphics/export.hpp"
 #include "LibGraphics/match/MatchResult.hpp"
 #include "LibGraphics/match/MatchOptions.hpp"
+#include "LibGraphics/match/PreparedTemplate.hpp"
+
+#include <optional>
+#include <vector>
 
 namespace LibGraphics::Match {
 
@@ -21,5 +26,81 @@ namespace LibGraphics::Match {
             const Image& match_target,
             const MatchOptions& options = MatchOptions()
         );
+
+        // View overloads, results are relative to the target view.
+        static MatchResult matchTemplateSingle(
+            const ImageView& match_template,
+            const ImageView& match_target,
+            const MatchOptions& options = MatchOptions()
+        );
+
+        static std::vector<MatchResult> matchTemplateMultiple(
+            const ImageView& match_template,
+            const ImageView& match_target,
+            const MatchOptions& options = MatchOptions()
+        );
+
+        /*
+         * Prepared template overloads, with the template side (conversion,
+         * statistics) taken from the template's caches and its own options.
+         * Scores are computed by FFT correlation with the normalisation of
+         * cv::matchTemplate.
+         *
+         * Both give the same results as the overloads above, including
+         * matchTemplateMultiple() ignoring MatchOptions::grayscale and always
+         * matching in colour.
+         */
+        static MatchResult matchTemplateSingle(
+            const PreparedTemplate& match_template,
+            const Image& match_target
+        );
+
+        static std::vector<MatchResult> matchTemplateMultiple(
+            const PreparedTemplate& match_template,
+            const Image& match_target
+        );
+
+        static MatchResult matchTemplateSingle(
+            const PreparedTemplate& match_template,
+            const ImageView& match_target
+        );
+
+        static std::vector<MatchResult> matchTemplateMultiple(
+            const PreparedTemplate& match_template,
+            const ImageView& match_target
+        );
+
+        /*
+         * Best match of every template against one target, as
+         * matchTemplateSingle() would give it. The target is converted, and
+         * its summed-area tables and spectra built, once for all templates,
+         * which are matched in parallel. Result i belongs to template i and is
+         * empty when that match stays under its threshold.
+         *
+         * Without `options` each template uses its own, so thresholds (and
+         * methods) can differ per template; with `options` all templates share
+         * them.
+         */
+        static std::vector<std::optional<MatchResult>> matchMany(
+            const std::vector<PreparedTemplate>& match_templates,
+            const Image& match_target
+        );
+
+        static std::vector<std::optional<MatchResult>> matchMany(
+            const std::vector<PreparedTemplate>& match_templates,
+            const Image& match_target,
+            const MatchOptions& options
+        );
+
+        static std::vector<std::optional<MatchResult>> matchMany(
+            const std::vector<PreparedTemplate>& match_templates,
+            const ImageView& match_target
+        );
+
+        static std::vector<std::optional<MatchResult>> matchMany(
+            const std::vector<PreparedTemplate>& match_templates,
+            const ImageView& match_target,
+            const MatchOptions& options
+        );
     };
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+#include "LibGraphics/memory/PixelAllocator.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace LibGraphics::Memory {
+
+    struct LIBGRAPHICS_API BufferPoolOptions {
+        size_t maxCachedBytes = size_t(512) << 20;  // Upper bound on memory kept for reuse
+        bool hugePages = false;                      // madvise(MADV_HUGEPAGE) large blocks (Linux only)
+        size_t hugePageThreshold = size_t(2) << 20;  // Blocks at least this big get huge page backing
+    };
+
+    struct LIBGRAPHICS_API BufferPoolStats {
+        uint64_t hits = 0;          // Allocations served from a cache
+        uint64_t threadHits = 0;    // ... of which came from the calling thread's own cache
+        uint64_t misses = 0;        // Allocations that went to the system
+        uint64_t released = 0;      // Frees that could not be cached and went back to the system
+        size_t cachedBytes = 0;     // Memory currently held in the shared size classes
+
+        [[nodiscard]] double hitRate() const {
+            const uint64_t total = hits + misses;
+            return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        }
+    };
+
+    /**
+     * @brief Size-class pool that recycles pixel buffers instead of returning them to malloc.
+     *
+     * Requests are rounded up to size classes (four per power of two), freed blocks
+     * are kept per class and handed out again to the next request of that class.
+     * Every thread keeps a few recently freed blocks of its own, with separate
+     * slots for small blocks such as PixelBuffer headers, so a decode, gray,
+     * crop, resize loop on one thread does not even touch the shared lock.
+     *
+     * Install it with Image::setAllocator(BufferPool::shared()).
+     */
+    class LIBGRAPHICS_API BufferPool : public PixelAllocator, public std::enable_shared_from_this<BufferPool> {
+    public:
+        explicit BufferPool(BufferPoolOptions options = BufferPoolOptions());
+        ~BufferPool() override;
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        void* allocate(size_t bytes) override;
+        void deallocate(void* ptr, size_t bytes) noexcept override;
+
+        [[nodiscard]] BufferPoolStats stats() const;
+        void resetStats();
+
+        /**
+         * @brief Returns every block cached in the shared size classes to the system.
+         */
+        void trim();
+
+        [[nodiscard]] const BufferPoolOptions& options() const { return options_; }
+
+        /**
+         * @brief Process-wide pool with default options.
+         */
+        static std::shared_ptr<BufferPool> shared();
+
+        static size_t sizeClass(size_t bytes);
+
+    private:
+        struct ThreadCache;
+
+        BufferPoolOptions options_;
+        uint64_t id_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<size_t, std::vector<void*>> free_;
+        size_t cachedBytes_ = 0;
+
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> threadHits_{0};
+        std::atomic<uint64_t> misses_{0};
+        std::atomic<uint64_t> released_{0};
+
+        void* allocateFromSystem(size_t classBytes);
+        bool cache(void* ptr, size_t classBytes) noexcept;
+        ThreadCache* threadCache() noexcept;
+    };
+}
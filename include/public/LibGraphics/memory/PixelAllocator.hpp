@@ -0,0 +1,35 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace LibGraphics::Memory {
+
+    /**
+     * @brief Source of the raw memory behind PixelBuffer storage.
+     *
+     * Implementations must return blocks aligned to at least `Alignment` bytes
+     * and must stay alive for as long as a buffer they allocated exists; a
+     * PixelBuffer keeps a reference to the allocator that created it.
+     */
+    class LIBGRAPHICS_API PixelAllocator {
+    public:
+        static constexpr size_t Alignment = 64;
+
+        virtual ~PixelAllocator() = default;
+
+        virtual void* allocate(size_t bytes) = 0;
+        virtual void deallocate(void* ptr, size_t bytes) noexcept = 0;
+
+        /**
+         * @brief Plain aligned heap allocator, the default for every PixelBuffer.
+         */
+        static std::shared_ptr<PixelAllocator> heap();
+    };
+
+    // Aligned system allocation shared by the built-in allocators.
+    LIBGRAPHICS_API void* alignedAlloc(size_t bytes, size_t alignment = PixelAllocator::Alignment);
+    LIBGRAPHICS_API void alignedFree(void* ptr) noexcept;
+}
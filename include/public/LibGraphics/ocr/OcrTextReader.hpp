@@ -1,6 +1,7 @@
 #pragma once
 
 #include "LibGraphics/Image.hpp"
+#include "LibGraphics/ImageView.hpp"
 #include "LibGraphics/export.hpp"
 #include "OcrResult.hpp"
 
@@ -8,7 +9,7 @@ namespace LibGraphics::Ocr {
     class LIBGRAPHICS_API OcrTextReader {
     public:
         static std::string CleanOcrOutput(const std::string& input);
-        static OcrResult ReadFromImage(const Image& image, const char &language = *"eng");
+        static OcrResult ReadFromImage(const ImageView& image, const char &language = *"eng");
     };
 }
 
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "LibGraphics/export.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace LibGraphics::Memory {
+    class PixelAllocator;
+}
+
+namespace LibGraphics::Type {
+
+    /**
+     * @brief Reference counted, copy-on-write byte buffer used for Image pixels.
+     *
+     * Copies share the same storage until one of them is written to. Every
+     * non-const accessor (data(), operator[], begin(), resize(), ...) detaches
+     * first, so reading from a non-const buffer that is shared also copies it;
+     * use constData() or a const reference when you only need to read.
+     *
+     * Storage comes from the allocator installed with setDefaultAllocator()
+     * at the time it is created (a plain aligned heap by default).
+     */
+    class LIBGRAPHICS_API PixelBuffer {
+    public:
+        using value_type     = uint8_t;
+        using size_type      = size_t;
+        using iterator       = uint8_t*;
+        using const_iterator = const uint8_t*;
+        using Deleter        = void (*)(void*);
+
+        PixelBuffer() = default;
+        explicit PixelBuffer(size_t size, uint8_t value = 0);
+        PixelBuffer(const uint8_t* first, const uint8_t* last);
+        PixelBuffer(std::initializer_list<uint8_t> values);
+        PixelBuffer(std::vector<uint8_t> bytes);
+
+        /**
+         * @brief Buffer of `size` bytes whose contents are left uninitialized.
+         */
+        static PixelBuffer uninitialized(size_t size);
+
+        /**
+         * @brief Takes ownership of memory allocated elsewhere, e.g. by a decoder.
+         *
+         * `deleter` is called with `bytes` once the last copy lets go of it, or
+         * as soon as the buffer has to grow beyond `size`.
+         */
+        static PixelBuffer adopt(uint8_t* bytes, size_t size, Deleter deleter);
+
+        PixelBuffer(const PixelBuffer& other) noexcept;
+        PixelBuffer(PixelBuffer&& other) noexcept;
+        ~PixelBuffer();
+
+        PixelBuffer& operator=(const PixelBuffer& other) noexcept;
+        PixelBuffer& operator=(PixelBuffer&& other) noexcept;
+        PixelBuffer& operator=(std::initializer_list<uint8_t> values);
+
+        [[nodiscard]] size_t size() const noexcept { return block_ ? block_->size : 0; }
+        [[nodiscard]] size_t capacity() const noexcept { return block_ ? block_->capacity : 0; }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] const uint8_t* constData() const noexcept { return block_ ? block_->bytes : nullptr; }
+        [[nodiscard]] const uint8_t* data() const noexcept { return constData(); }
+        [[nodiscard]] uint8_t* data() {
+            detach();
+            return block_ ? block_->bytes : nullptr;
+        }
+
+        const uint8_t& operator[](size_t index) const noexcept { return block_->bytes[index]; }
+        uint8_t& operator[](size_t index) {
+            detach();
+            return block_->bytes[index];
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return constData(); }
+        [[nodiscard]] const_iterator end() const noexcept { return constData() + size(); }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+        [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+        [[nodiscard]] iterator begin() { return data(); }
+        [[nodiscard]] iterator end() { return data() + size(); }
+
+        void resize(size_t size);
+        void resize(size_t size, uint8_t value);
+        void assign(size_t size, uint8_t value);
+        void assign(const uint8_t* first, const uint8_t* last);
+        void reserve(size_t capacity);
+        void clear();
+
+        /**
+         * @brief Gives this buffer its own copy of the bytes if they are shared.
+         */
+        void detach() {
+            if (block_ && block_->refs.load(std::memory_order_acquire) > 1)
+                detachSlow();
+        }
+
+        [[nodiscard]] bool isShared() const noexcept { return block_ && block_->refs.load(std::memory_order_acquire) > 1; }
+        [[nodiscard]] long useCount() const noexcept { return block_ ? block_->refs.load(std::memory_order_acquire) : 0; }
+
+        [[nodiscard]] std::vector<uint8_t> toVector() const { return {begin(), end()}; }
+
+        /**
+         * @brief Allocator used for buffers created from now on.
+         *
+         * Existing buffers keep the allocator they were created with. Passing
+         * nullptr restores the default heap allocator.
+         */
+        static void setDefaultAllocator(std::shared_ptr<Memory::PixelAllocator> allocator);
+        [[nodiscard]] static std::shared_ptr<Memory::PixelAllocator> defaultAllocator();
+
+        /**
+         * @brief Opaque data tied to the current storage, shared by every copy.
+         *
+         * Image keeps its derived cv::Mat representations here so copies that
+         * share pixels also share them. The attachment is dropped whenever the
+         * storage is detached, resized or reassigned; writing single bytes does
+         * not drop it.
+         *
+         * Reading, setting and compare-exchanging the attachment are atomic, so
+         * threads that share the storage may race to install one.
+         */
+        [[nodiscard]] std::shared_ptr<void> attachment() const;
+        void setAttachment(std::shared_ptr<void> value) const;
+
+        /**
+         * @brief Installs `desired` only if the attachment is still `expected`.
+         * @return false, with `expected` updated to the current attachment, when another thread got there first.
+         */
+        bool compareExchangeAttachment(std::shared_ptr<void>& expected, std::shared_ptr<void> desired) const;
+
+        friend LIBGRAPHICS_API bool operator==(const PixelBuffer& lhs, const PixelBuffer& rhs);
+        friend LIBGRAPHICS_API bool operator==(const PixelBuffer& lhs, const std::vector<uint8_t>& rhs);
+        friend bool operator==(const std::vector<uint8_t>& lhs, const PixelBuffer& rhs) { return rhs == lhs; }
+        friend bool operator!=(const PixelBuffer& lhs, const PixelBuffer& rhs) { return !(lhs == rhs); }
+        friend bool operator!=(const PixelBuffer& lhs, const std::vector<uint8_t>& rhs) { return !(lhs == rhs); }
+        friend bool operator!=(const std::vector<uint8_t>& lhs, const PixelBuffer& rhs) { return !(rhs == lhs); }
+
+    private:
+        struct Block {
+            std::atomic<long> refs{1};
+            uint8_t* bytes = nullptr;
+            size_t size = 0;
+            size_t capacity = 0;
+            std::shared_ptr<Memory::PixelAllocator> allocator;  // Allocated the block, and `bytes` unless adopted
+            std::vector<uint8_t> adopted;                        // Owns `bytes` when a vector was adopted
+            Deleter deleter = nullptr;                           // Frees `bytes` when foreign memory was adopted
+            std::shared_ptr<void> attachment;
+        };
+
+        Block* block_ = nullptr;
+
+        void detachSlow();
+        Block* ownBlock();
+        static Block* createBlock(size_t capacity);
+        static void reallocate(Block* block, size_t capacity, bool preserve);
+        static void freeBytes(Block* block) noexcept;
+        static void release(Block* block) noexcept;
+    };
+}
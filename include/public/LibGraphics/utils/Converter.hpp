@@ -1,18 +1,21 @@
 #pragma once
 
 #include "LibGraphics/Image.hpp"
+#include "LibGraphics/ImageView.hpp"
 
 #include <leptonica/allheaders.h>
 #include <opencv2/core/mat.hpp>
 
 using LibGraphics::Image;
+using LibGraphics::ImageView;
 
 namespace LibGraphics::Utils {
     class Converter {
     public:
         static cv::Mat ImageToMat(const Image &image);
         static Image MatToImage(const cv::Mat &mat);
-        static Pix *imageToPix(Image &image);
+        static Pix *imageToPix(const Image &image);
+        static Pix *viewToPix(const ImageView &view);
         static Image pixToImage(Pix *pix);
     };
 };
\ No newline at end of file
@@ -3,6 +3,13 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include "LibGraphics/Image.hpp"
+#include "LibGraphics/detail/ImageCache.hpp"
+#include "LibGraphics/io/MappedFile.hpp"
+#include "LibGraphics/io/SpngCodec.hpp"
+#include "LibGraphics/io/TurboJpegDecoder.hpp"
+#include "LibGraphics/kernels/Channels.hpp"
+#include "LibGraphics/kernels/Grayscale.hpp"
+#include "LibGraphics/kernels/Redact.hpp"
 #include "LibGraphics/modules/stb_image_write.hpp"
 #include "LibGraphics/modules/stb_image.hpp"
 
@@ -14,6 +21,10 @@
 #include <limits>
 #include <sstream>
 #include <chrono>
+#include <utility>
+#include <fstream>
+#include <atomic>
+#include <cctype>
 
 #ifdef _WIN32
 #define NOMINMAX
@@ -31,120 +42,382 @@ namespace LibGraphics {
         return (std::filesystem::temp_directory_path() / oss.str()).string();
     }
 
-    void Image::invalidateCache() const {
-        cachedColor.release();
-        cachedGray.release();
+    std::shared_ptr<Detail::ImageCache> Image::findCache(const std::shared_ptr<void> &head) const {
+        const uint8_t *source = data.constData();
+
+        for (auto cache = std::static_pointer_cast<Detail::ImageCache>(head); cache; cache = cache->next) {
+            if (cache->matches(source, width, height, channels, rowStride()))
+                return cache;
+        }
+        return nullptr;
     }
 
-    void Image::stripAlpha(std::vector<uint8_t> &pixels, int width, int height, int &channels) {
-        if (channels == 4) {
-            std::vector<uint8_t> rgb;
-            rgb.reserve(static_cast<size_t>(width) * height * 3);
+    std::shared_ptr<Detail::ImageCache> Image::cacheFor() const {
+        auto current = data.attachment();
+
+        for (;;) {
+            if (auto cache = findCache(current))
+                return cache;
+
+            // The attachment owns the cache, copies sharing these pixels pick it up as well. Images that
+            // read the same pixels with another geometry are chained in front, never replaced, so a
+            // cache someone is still reading stays alive.
+            auto fresh = std::make_shared<Detail::ImageCache>();
+            fresh->source = data.constData();
+            fresh->width = width;
+            fresh->height = height;
+            fresh->channels = channels;
+            fresh->stride = rowStride();
+            fresh->next = std::static_pointer_cast<Detail::ImageCache>(current);
+
+            // Several readers may get here at once; the first one to publish wins and the rest adopt its cache.
+            if (data.compareExchangeAttachment(current, fresh))
+                return fresh;
+        }
+    }
 
-            for (size_t i = 0; i < pixels.size(); i += 4) {
-                rgb.push_back(pixels[i + 0]);
-                rgb.push_back(pixels[i + 1]);
-                rgb.push_back(pixels[i + 2]);
-            }
+    void Image::markDirty(const Rect &rect) {
+        const Rect dirty = rect.intersect(Rect{0, 0, width, height});
+        if (dirty.Width <= 0 || dirty.Height <= 0) return;
+
+        const auto cache = findCache(data.attachment());
+        if (!cache) return;
+
+        // The colour slot is a header over `data`, it already sees the write. Derived
+        // planes are only patched if they were built; otherwise they are built fresh later.
+        if (!cache->planes.empty()) {
+            // Read through the const rowPtr(): the non-const one would detach a shared buffer.
+            const uint8_t *src = std::as_const(*this).rowPtr(dirty.Y) + static_cast<size_t>(dirty.X) * channels;
+            const cv::Mat region(dirty.Height, dirty.Width, CV_8UC(channels), const_cast<uint8_t *>(src), rowStride());
+            std::vector<cv::Mat> parts;
+            for (const cv::Mat &full: cache->planes)
+                parts.push_back(full(cv::Rect(dirty.X, dirty.Y, dirty.Width, dirty.Height)));
+
+            // The parts already have the right size, so split writes into the cached planes.
+            cv::split(region, parts.data());
+        }
 
+        if (!cache->gray.empty() && channels != 1) {
+            const uint8_t *src = std::as_const(*this).rowPtr(dirty.Y) + static_cast<size_t>(dirty.X) * channels;
+            uint8_t *dst = cache->gray.ptr<uint8_t>(dirty.Y) + dirty.X;
+
+            Kernels::grayscale(src, rowStride(), dst, cache->gray.step, dirty.Width, dirty.Height, channels, Kernels::ChannelOrder::BGR);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(cache->pyramidMutex);
+            cache->levels.clear();
+        }
+
+        std::lock_guard<std::mutex> lock(cache->integralMutex);
+        cache->integral = IntegralImage();
+        cache->grayIntegral = IntegralImage();
+    }
+
+    namespace {
+        // Matches stb_image_write's default so output is unchanged unless someone asks.
+        std::atomic<int> pngLevel{8};
+    }
+
+    void Image::setAllocator(std::shared_ptr<Memory::PixelAllocator> allocator) {
+        PixelBuffer::setDefaultAllocator(std::move(allocator));
+    }
+
+    std::shared_ptr<Memory::PixelAllocator> Image::allocator() {
+        return PixelBuffer::defaultAllocator();
+    }
+
+    void Image::stripAlpha(PixelBuffer &pixels, int width, int height, int &channels) {
+        if (channels != 4) return;
+
+        const size_t count = static_cast<size_t>(width) * height;
+
+        if (pixels.isShared()) {
+            // Someone else still reads the RGBA bytes, compact into fresh storage instead of copying first.
+            PixelBuffer rgb = PixelBuffer::uninitialized(count * 3);
+            Kernels::stripAlpha(pixels.constData(), rgb.data(), count);
             pixels = std::move(rgb);
-            channels = 3;
+        } else {
+            uint8_t *bytes = pixels.data();
+            Kernels::stripAlpha(bytes, bytes, count);
+            pixels.resize(count * 3);
         }
+
+        channels = 3;
     }
 
-    Image::Image(int width, int height, int channels, std::vector<uint8_t> pixels)
-        : width(width), height(height), channels(channels) {
+    Image::Image(int width, int height, int channels, PixelBuffer pixels)
+        : Image(width, height, channels, std::move(pixels), 0) {}
+
+    Image::Image(int width, int height, int channels, PixelBuffer pixels, size_t stride)
+        : width(width), height(height), channels(channels), stride(stride) {
         if (width <= 0 || height <= 0 || channels <= 0)
             throw std::invalid_argument("[Image] Invalid dimensions or channel count");
 
-        if (pixels.size() != static_cast<size_t>(width * height * channels))
+        if (stride != 0 && stride < static_cast<size_t>(width) * channels)
+            throw std::invalid_argument("[Image] Stride is shorter than a row");
+
+        if (pixels.size() != rowStride() * height)
             throw std::invalid_argument("[Image] Pixel buffer size does not match dimensions");
 
-        stripAlpha(pixels, width, height, this->channels);
+        if (isPacked()) {
+            stripAlpha(pixels, width, height, this->channels);
+            // An explicit packed stride still describes the RGBA rows.
+            if (this->channels != channels) this->stride = 0;
+        } else if (channels == 4) {
+            // Padded rows cannot be compacted in place; strip row by row into an aligned layout.
+            Image rgb = allocate(width, height, 3, true);
+            for (int y = 0; y < height; ++y)
+                Kernels::stripAlpha(pixels.constData() + static_cast<size_t>(y) * stride, rgb.rowPtr(y), static_cast<size_t>(width));
+
+            pixels = std::move(rgb.data);
+            this->channels = 3;
+            this->stride = rgb.stride;
+        }
 
         data = std::move(pixels);
         origin = "buffer";
     }
 
-    Image Image::load(const std::string &path) {
-        int w, h, c;
-        unsigned char *raw = stbi_load(path.c_str(), &w, &h, &c, 0);
+    Image Image::allocate(int width, int height, int channels, bool alignRows) {
+        if (width <= 0 || height <= 0 || channels <= 0)
+            throw std::invalid_argument("[Image::allocate] Invalid dimensions or channel count");
 
-        if (!raw)
-            throw std::runtime_error("Failed to load image: " + path);
+        Image out;
+        out.width = width;
+        out.height = height;
+        out.channels = channels;
+        out.stride = alignRows ? alignedStride(width, channels) : 0;
+        out.data = PixelBuffer::uninitialized(out.rowStride() * height);
+        out.origin = "buffer";
+        return out;
+    }
+
+    size_t Image::alignedStride(int width, int channels) {
+        const size_t rowBytes = static_cast<size_t>(width) * channels;
+        return (rowBytes + RowAlignment - 1) / RowAlignment * RowAlignment;
+    }
 
-        std::vector<uint8_t> pixels(raw, raw + (w * h * c));
-        stbi_image_free(raw);
+    Image Image::aligned() const {
+        if (!isValid()) return Image();
 
-        stripAlpha(pixels, w, h, c);
+        const size_t step = rowStride();
+        const auto base = reinterpret_cast<uintptr_t>(data.constData());
+
+        if (step % RowAlignment == 0 && base % RowAlignment == 0) {
+            // Already aligned, only mark the layout so derived images keep it.
+            Image out = *this;
+            out.stride = step;
+            return out;
+        }
+
+        Image out = allocate(width, height, channels, true);
+        copyRows(*this, out);
+        out.origin = origin;
+        return out;
+    }
+
+    Image Image::packed() const {
+        if (!isValid()) return Image();
+
+        if (isPacked()) {
+            Image out = *this;
+            out.stride = 0;
+            return out;
+        }
+
+        Image out = allocate(width, height, channels, false);
+        copyRows(*this, out);
+        out.origin = origin;
+        return out;
+    }
+
+    void Image::copyRows(const Image &src, Image &dst) {
+        const size_t rowBytes = static_cast<size_t>(src.width) * src.channels;
+        for (int y = 0; y < src.height; ++y)
+            std::memcpy(dst.rowPtr(y), src.rowPtr(y), rowBytes);
+    }
+
+    Image Image::decode(const uint8_t *bytes, size_t size, const LoadOptions &options) {
+        const int scale = options.scaleDenominator;
+        if (scale != 1 && scale != 2 && scale != 4 && scale != 8)
+            throw std::invalid_argument("[Image] LoadOptions::scaleDenominator must be 1, 2, 4 or 8");
+
+#ifdef LIBGRAPHICS_WITH_TURBOJPEG
+        if (IO::isJpeg(bytes, size)) {
+            // Scaling and grayscale happen inside the decoder, nothing left to do afterwards.
+            IO::DecodedImage decoded = IO::decodeTurboJpeg(bytes, size, options);
+            if (!decoded.pixels.empty())
+                return Image(decoded.width, decoded.height, decoded.channels, std::move(decoded.pixels), decoded.stride);
+        }
+#endif
+
+        Image img;
+
+#ifdef LIBGRAPHICS_WITH_SPNG
+        if (IO::isPng(bytes, size)) {
+            IO::DecodedImage decoded = IO::decodeSpng(bytes, size);
+            if (!decoded.pixels.empty())
+                img = Image(decoded.width, decoded.height, decoded.channels, std::move(decoded.pixels));
+        }
+#endif
+
+        if (!img.isValid()) {
+            int w = 0, h = 0, c = 0;
+            stbi_uc *raw = nullptr;
+
+            if (size <= static_cast<size_t>(std::numeric_limits<int>::max()))
+                raw = stbi_load_from_memory(bytes, static_cast<int>(size), &w, &h, &c, 0);
+
+            if (!raw) return Image();
+
+            // The decoder's buffer becomes the image storage; alpha is compacted away inside it.
+            PixelBuffer pixels = PixelBuffer::adopt(raw, static_cast<size_t>(w) * h * c, stbi_image_free);
+            stripAlpha(pixels, w, h, c);
+
+            img = Image(w, h, c, std::move(pixels));
+        }
+
+        // These decoders cannot scale or skip chroma; convert afterwards, gray first so the resize moves fewer bytes.
+        if (options.grayscale && img.channels != 1)
+            img = img.toGrayscale();
+
+        if (scale != 1)
+            img = img.resize((img.width + scale - 1) / scale, (img.height + scale - 1) / scale);
+
+        if (options.alignRows)
+            img = img.aligned();
 
-        Image img(w, h, c, std::move(pixels));
-        img.origin = path;
         return img;
     }
 
-    Image Image::load_from_memory(const uint8_t *buffer, size_t size) {
-        int w = 0, h = 0, c = 0;
-        stbi_uc *raw = stbi_load_from_memory(buffer, static_cast<int>(size), &w, &h, &c, 0);
+    Image Image::load(const std::string &path, const LoadOptions &options) {
+        // Decode straight from the mapped file; no stdio buffering and no second copy of the bytes.
+        const IO::MappedFile file(path);
 
-        if (!raw)
-            throw std::runtime_error("[Image::load_from_memory] Failed to decode image");
+        Image img = file.isOpen() ? decode(file.data(), file.size(), options) : Image();
+
+        if (!img.isValid())
+            throw std::runtime_error("Failed to load image: " + path);
 
-        std::vector<uint8_t> pixels(raw, raw + (w * h * c));
-        stbi_image_free(raw);
+        img.origin = path;
+        return img;
+    }
 
-        stripAlpha(pixels, w, h, c);
+    Image Image::load_from_memory(const uint8_t *buffer, size_t size, const LoadOptions &options) {
+        Image img = decode(buffer, size, options);
+
+        if (!img.isValid())
+            throw std::runtime_error("[Image::load_from_memory] Failed to decode image");
 
-        Image img(w, h, c, std::move(pixels));
         img.origin = "memory";
         return img;
     }
 
-    Image Image::load_from_memory(const std::vector<uint8_t> &buffer) {
-        return load_from_memory(buffer.data(), buffer.size());
+    Image Image::load_from_memory(const std::vector<uint8_t> &buffer, const LoadOptions &options) {
+        return load_from_memory(buffer.data(), buffer.size(), options);
+    }
+
+    namespace {
+        std::string normalizeFormat(std::string format) {
+            if (!format.empty() && format.front() == '.') format.erase(0, 1);
+            std::transform(format.begin(), format.end(), format.begin(),
+                           [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+            return format == "jpeg" ? "jpg" : format;
+        }
+
+        bool isEncodable(const std::string &format) {
+            return format == "png" || format == "jpg" || format == "bmp" || format == "tga";
+        }
+
+        // stb_image_write sink that forwards every chunk to the caller's callback.
+        void forwardChunk(void *context, void *bytes, int size) {
+            (*static_cast<const Image::EncodeCallback *>(context))(static_cast<const uint8_t *>(bytes), static_cast<size_t>(size));
+        }
     }
 
     bool Image::save(const std::string &path, int quality) const {
         if (!isValid()) return false;
 
-        std::string ext = path.substr(path.find_last_of('.') + 1);
-        int result = 0;
+        std::string format = normalizeFormat(path.substr(path.find_last_of('.') + 1));
+        if (!isEncodable(format)) format = "png";
+
+        // Encoded before the file is opened, so a failed encode leaves an existing file untouched.
+        const std::vector<uint8_t> bytes = encode(format, quality);
+        if (bytes.empty()) return false;
+
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+
+        out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return out.good();
+    }
+
+    std::vector<uint8_t> Image::encode(const std::string &format, int quality) const {
+        std::vector<uint8_t> out;
+
+        // PNG arrives in one piece, JPEG in many small ones; guess generously to avoid regrowing.
+        out.reserve(data.size() / 4);
+
+        const bool encoded = encode(format, [&out](const uint8_t *bytes, size_t size) {
+            out.insert(out.end(), bytes, bytes + size);
+        }, quality);
+
+        if (!encoded) out.clear();
+        return out;
+    }
+
+    bool Image::encode(const std::string &format, const EncodeCallback &sink, int quality) const {
+        const std::string f = normalizeFormat(format);
+        if (!isEncodable(f))
+            throw std::invalid_argument("[Image::encode] Unsupported format: " + format);
+
+        if (!isValid()) return false;
+
+        // Only the PNG writers take a row stride.
+        if (f != "png" && !isPacked())
+            return packed().encode(f, sink, quality);
+
+        auto *context = const_cast<EncodeCallback *>(&sink);
+        const uint8_t *pixels = data.constData();
+
+        if (f == "jpg")
+            return stbi_write_jpg_to_func(forwardChunk, context, width, height, channels, pixels, quality) != 0;
+        if (f == "bmp")
+            return stbi_write_bmp_to_func(forwardChunk, context, width, height, channels, pixels) != 0;
+        if (f == "tga")
+            return stbi_write_tga_to_func(forwardChunk, context, width, height, channels, pixels) != 0;
 
-        if (ext == "png" || ext == "PNG")
-            result = stbi_write_png(path.c_str(), width, height, channels, data.data(), width * channels);
-        else if (ext == "jpg" || ext == "jpeg" || ext == "JPG" || ext == "JPEG")
-            result = stbi_write_jpg(path.c_str(), width, height, channels, data.data(), quality);
-        else if (ext == "bmp" || ext == "BMP")
-            result = stbi_write_bmp(path.c_str(), width, height, channels, data.data());
-        else if (ext == "tga" || ext == "TGA")
-            result = stbi_write_tga(path.c_str(), width, height, channels, data.data());
-        else
-            result = stbi_write_png(path.c_str(), width, height, channels, data.data(), width * channels);
+#ifdef LIBGRAPHICS_WITH_SPNG
+        const std::vector<uint8_t> png = IO::encodeSpng(pixels, width, height, channels, rowStride(), pngCompressionLevel());
+        if (png.empty()) return false;
 
-        return result != 0;
+        sink(png.data(), png.size());
+        return true;
+#else
+        return stbi_write_png_to_func(forwardChunk, context, width, height, channels, pixels, static_cast<int>(rowStride())) != 0;
+#endif
+    }
+
+    void Image::setPngCompressionLevel(int level) {
+        level = std::clamp(level, 0, 9);
+        pngLevel.store(level, std::memory_order_relaxed);
+
+        // stb_image_write only has a global for this; it is read once per encode.
+        stbi_write_png_compression_level = level;
+    }
+
+    int Image::pngCompressionLevel() {
+        return pngLevel.load(std::memory_order_relaxed);
     }
 
     Image Image::crop(int x, int y, int w, int h) const {
-        if (x < 0 || y < 0 || x + w > width || y + h > height) {
+        const ImageView region = view(x, y, w, h);
+        if (!region) {
             return Image();
         }
 
-        Image out;
-        out.width = w;
-        out.height = h;
-        out.channels = channels;
-        out.data.resize(static_cast<size_t>(w) * h * channels);
-
-        for (int row = 0; row < h; ++row) {
-            for (int col = 0; col < w; ++col) {
-                for (int c = 0; c < channels; ++c) {
-                    size_t src = ((y + row) * width + (x + col)) * channels + c;
-                    size_t dst = (row * w + col) * channels + c;
-                    out.data[dst] = data[src];
-                }
-            }
-        }
-
+        Image out = region.toImage(stride != 0);
         out.origin = origin;
         return out;
     }
@@ -160,16 +433,13 @@ namespace LibGraphics {
                      ? cv::INTER_AREA      // beste voor downscale
                      : cv::INTER_LINEAR;   // beste voor upscale
 
-        cv::Mat dst;
-        cv::resize(src, dst, cv::Size(newW, newH), 0, 0, interp);
-
-        Image out;
-        out.width = newW;
-        out.height = newH;
-        out.channels = channels;
-        out.data.assign(dst.data, dst.data + dst.total() * dst.elemSize());
+        Image out = allocate(newW, newH, channels, stride != 0);
         out.origin = origin;
 
+        // Resize straight into the new buffer, cv::resize keeps a destination of the right shape.
+        cv::Mat dst(newH, newW, CV_8UC(channels), out.data.data(), out.rowStride());
+        cv::resize(src, dst, cv::Size(newW, newH), 0, 0, interp);
+
         return out;
     }
 
@@ -200,32 +470,122 @@ namespace LibGraphics {
         if (!isValid()) return Image();
         if (channels == 1) return clone();
 
-        std::vector<uint8_t> gray(width * height);
+        Image out = allocate(width, height, 1, stride != 0);
+        Kernels::grayscale(data.constData(), rowStride(), out.data.data(), out.rowStride(), width, height, channels, Kernels::ChannelOrder::RGB);
 
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                size_t idx = (static_cast<size_t>(y) * width + x) * channels;
-                uint8_t r = data[idx + 0];
-                uint8_t g = data[idx + 1];
-                uint8_t b = data[idx + 2];
+        out.origin = origin;
+        return out;
+    }
 
-                gray[y * width + x] = static_cast<uint8_t>(
-                    0.299 * r + 0.587 * g + 0.114 * b
-                );
+    bool Image::isValid() const {
+        if (width <= 0 || height <= 0 || channels <= 0) return false;
+        if (stride != 0 && stride < static_cast<size_t>(width) * channels) return false;
+        return data.size() == rowStride() * height;
+    }
+
+    const cv::Mat &Image::plane(int channel) const {
+        if (!isValid())
+            throw std::runtime_error("[Image::plane] Invalid image");
+        if (channel < 0 || channel >= channels)
+            throw std::out_of_range("[Image::plane] Channel out of range");
+
+        const cv::Mat &color = mat();
+        if (channels == 1) return color;
+
+        // Held for the whole call, so the slots cannot go away underneath it.
+        const auto cache = cacheFor();
+        Detail::ImageCache &c = *cache;
+
+        std::call_once(c.planesOnce, [&] {
+            std::vector<cv::Mat> planes;
+            for (int i = 0; i < channels; ++i) {
+                // Same row padding as the gray plane, see matGray().
+                planes.push_back(stride != 0
+                                 ? cv::Mat(height, static_cast<int>(alignedStride(width, 1)), CV_8UC1).colRange(0, width)
+                                 : cv::Mat(height, width, CV_8UC1));
             }
+
+            // mat() keeps the bytes in storage order, so plane i is image channel i.
+            cv::split(color, planes.data());
+            c.planes = std::move(planes);
+        });
+
+        return c.planes[channel];
+    }
+
+    Image Image::pyramidLevel(int level) const {
+        if (level < 0)
+            throw std::invalid_argument("[Image::pyramidLevel] Level must not be negative");
+        if (!isValid())
+            throw std::runtime_error("[Image::pyramidLevel] Invalid image");
+
+        if (level == 0) return *this;
+
+        // Held for the whole call, so the slots cannot go away underneath it.
+        const auto cache = cacheFor();
+        Detail::ImageCache &c = *cache;
+        std::lock_guard<std::mutex> lock(c.pyramidMutex);
+
+        while (static_cast<int>(c.levels.size()) < level) {
+            const Image &prev = c.levels.empty() ? *this : c.levels.back();
+            c.levels.push_back(prev.resize((prev.width + 1) / 2, (prev.height + 1) / 2));
         }
 
-        Image out(width, height, 1, std::move(gray));
-        out.origin = origin;
+        return c.levels[level - 1];
+    }
+
+    std::vector<Image> Image::pyramid(int levels) const {
+        std::vector<Image> out;
+        if (levels <= 0) return out;
+
+        out.push_back(pyramidLevel(0));
+        while (static_cast<int>(out.size()) < levels && (out.back().width > 1 || out.back().height > 1))
+            out.push_back(pyramidLevel(static_cast<int>(out.size())));
+
         return out;
     }
 
-    bool Image::isValid() const {
-        if (width <= 0 || height <= 0 || channels <= 0) return false;
-        return data.size() == static_cast<size_t>(width) * height * channels;
+    IntegralImage Image::integral() const {
+        if (!isValid())
+            throw std::runtime_error("[Image::integral] Invalid image");
+
+        // Held for the whole call, so the slots cannot go away underneath it.
+        const auto cache = cacheFor();
+        Detail::ImageCache &c = *cache;
+        std::lock_guard<std::mutex> lock(c.integralMutex);
+
+        if (!c.integral) {
+            // mat() presents the bytes as they are stored, so table channel i is image channel i.
+            cv::Mat sum, squaredSum;
+            cv::integral(mat(), sum, squaredSum, CV_64F, CV_64F);
+            c.integral = IntegralImage(sum, squaredSum);
+        }
+
+        return c.integral;
+    }
+
+    IntegralImage Image::integralGray() const {
+        if (!isValid())
+            throw std::runtime_error("[Image::integralGray] Invalid image");
+
+        if (channels == 1) return integral();
+
+        // Held for the whole call, so the slots cannot go away underneath it.
+        const auto cache = cacheFor();
+        Detail::ImageCache &c = *cache;
+        std::lock_guard<std::mutex> lock(c.integralMutex);
+
+        if (!c.grayIntegral) {
+            cv::Mat sum, squaredSum;
+            cv::integral(matGray(), sum, squaredSum, CV_64F, CV_64F);
+            c.grayIntegral = IntegralImage(sum, squaredSum);
+        }
+
+        return c.grayIntegral;
     }
 
     Image Image::clone() const {
+        // Pixels are copy-on-write, so this only bumps a reference count.
         Image copy = *this;
         return copy;
     }
@@ -235,79 +595,117 @@ namespace LibGraphics {
         if (x < 0 || x >= width || y < 0 || y >= height)
             throw std::out_of_range("[Image::getRGB] Out of bounds");
 
-        size_t idx = (static_cast<size_t>(y) * width + x) * channels;
+        const uint8_t *px = rowPtr(y) + static_cast<size_t>(x) * channels;
 
-        if (channels == 1) {
-            uint8_t g = data[idx];
-            return {g, g, g};
+        if (channels < 3) {
+            return {px[0], px[0], px[0]};
         }
 
-        return {data[idx], data[idx + 1], data[idx + 2]};
+        return {px[0], px[1], px[2]};
     }
 
     void Image::redact(const Rect &roi, uint8_t value) {
-        if (!isValid()) return;
-
-        int x0 = std::max(0, roi.X);
-        int y0 = std::max(0, roi.Y);
-        int x1 = std::min(width, roi.X + roi.Width);
-        int y1 = std::min(height, roi.Y + roi.Height);
-
-        for (int y = y0; y < y1; ++y) {
-            for (int x = x0; x < x1; ++x) {
-                size_t idx = (static_cast<size_t>(y) * width + x) * channels;
-                if (channels == 1) {
-                    data[idx] = value;
-                } else {
-                    data[idx + 0] = value;
-                    data[idx + 1] = value;
-                    data[idx + 2] = value;
-                }
-            }
-        }
-
-        invalidateCache();
+        redact(std::vector<Rect>{roi}, RedactOptions().solid(value));
     }
 
     void Image::redact(const std::vector<Rect> &rois, uint8_t value) {
-        for (const auto &r: rois) redact(r, value);
+        redact(rois, RedactOptions().solid(value));
+    }
+
+    void Image::redact(const Rect &roi, const RedactOptions &options) {
+        redact(std::vector<Rect>{roi}, options);
+    }
+
+    void Image::redact(const std::vector<Rect> &rois, const RedactOptions &options) {
+        if (options.fill == RedactOptions::Fill::Pixelate && (options.blockSize < 1 || options.blockSize > Kernels::MaxPixelBlock))
+            throw std::invalid_argument("[Image::redact] Pixelate block size must be between 1 and 4096");
+        if (options.fill == RedactOptions::Fill::Blur && (options.radius < 1 || options.radius > Kernels::MaxBlurRadius))
+            throw std::invalid_argument("[Image::redact] Blur radius must be between 1 and 2048");
+
+        if (!isValid() || rois.empty()) return;
+
+        const std::vector<Kernels::RowSpan> spans = Kernels::mergeSpans(rois, width, height);
+        if (spans.empty()) return;
+
+        const size_t step = rowStride();
+        const int colorChannels = channels >= 3 ? 3 : 1;
+        uint8_t *pixels = data.data();
+
+        switch (options.fill) {
+            case RedactOptions::Fill::Solid: {
+                const auto &[r, g, b] = options.color;
+                const uint8_t gray = Kernels::grayPixel(r, g, b);
+                const uint8_t color[3] = {colorChannels == 1 ? gray : r, g, b};
+                Kernels::fillSpans(pixels, step, channels, colorChannels, spans, color);
+                break;
+            }
+            case RedactOptions::Fill::Pixelate:
+                Kernels::pixelateSpans(pixels, step, width, channels, colorChannels, spans, options.blockSize);
+                break;
+            case RedactOptions::Fill::Blur:
+                Kernels::blurSpans(pixels, step, width, height, channels, colorChannels, rois, spans, options.radius);
+                break;
+        }
+
+        for (const Rect &dirty: Kernels::mergeRects(rois, width, height))
+            markDirty(dirty);
     }
 
     cv::Mat &Image::mat() {
         if (!isValid())
             throw std::runtime_error("[Image::mat] Invalid image");
 
-        if (!cachedColor.empty())
-            return cachedColor;
-
-        int type = (channels == 1) ? CV_8UC1 : CV_8UC3;
-        cachedColor = cv::Mat(height, width, type, data.data()).clone();
-        return cachedColor;
+        // The caller may write through the header, so the pixels have to be ours.
+        data.detach();
+        return const_cast<cv::Mat &>(std::as_const(*this).mat());
     }
 
     const cv::Mat &Image::mat() const {
-        return const_cast<Image *>(this)->mat();
+        if (!isValid())
+            throw std::runtime_error("[Image::mat] Invalid image");
+
+        // Held for the whole call, so the slots cannot go away underneath it.
+        const auto cache = cacheFor();
+        Detail::ImageCache &c = *cache;
+
+        std::call_once(c.colorOnce, [&] {
+            c.color = cv::Mat(height, width, CV_8UC(channels), const_cast<uint8_t *>(data.constData()), rowStride());
+        });
+
+        return c.color;
     }
 
     cv::Mat &Image::matGray() {
         if (!isValid())
             throw std::runtime_error("[Image::matGray] Invalid image");
 
-        if (!cachedGray.empty())
-            return cachedGray;
+        data.detach();
+        return const_cast<cv::Mat &>(std::as_const(*this).matGray());
+    }
 
-        cv::Mat &color = mat();
+    const cv::Mat &Image::matGray() const {
+        if (!isValid())
+            throw std::runtime_error("[Image::matGray] Invalid image");
 
-        if (channels == 1) {
-            cachedGray = color.clone();
-        } else {
-            cv::cvtColor(color, cachedGray, cv::COLOR_BGR2GRAY);
-        }
+        const cv::Mat &color = mat();
 
-        return cachedGray;
-    }
+        if (channels == 1)
+            return color;
 
-    const cv::Mat &Image::matGray() const {
-        return const_cast<Image *>(this)->matGray();
+        // Held for the whole call, so the slots cannot go away underneath it.
+        const auto cache = cacheFor();
+        Detail::ImageCache &c = *cache;
+
+        std::call_once(c.grayOnce, [&] {
+            // Same kernel as toGrayscale(), weighted as BGR because that is how mat() presents the bytes.
+            // Padded images get a padded plane too, so its rows stay aligned.
+            cv::Mat gray = stride != 0
+                           ? cv::Mat(height, static_cast<int>(alignedStride(width, 1)), CV_8UC1).colRange(0, width)
+                           : cv::Mat(height, width, CV_8UC1);
+            Kernels::grayscale(color.data, color.step, gray.data, gray.step, width, height, channels, Kernels::ChannelOrder::BGR);
+            c.gray = gray;
+        });
+
+        return c.gray;
     }
 }
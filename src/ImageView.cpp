@@ -0,0 +1,71 @@
+#include "LibGraphics/ImageView.hpp"
+#include "LibGraphics/Image.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace LibGraphics {
+
+    ImageView::ImageView(const uint8_t *pixels, int width, int height, int channels, size_t stride)
+        : pixels(pixels), width(width), height(height), channels(channels),
+          stride(stride != 0 ? stride : static_cast<size_t>(width) * channels) {}
+
+    ImageView::ImageView(const Image &image) {
+        if (!image.isValid()) return;
+
+        pixels = image.data.constData();
+        width = image.width;
+        height = image.height;
+        channels = image.channels;
+        stride = image.rowStride();
+    }
+
+    bool ImageView::isValid() const {
+        return pixels != nullptr && width > 0 && height > 0 && channels > 0 &&
+               stride >= static_cast<size_t>(width) * channels;
+    }
+
+    ImageView ImageView::crop(int x, int y, int w, int h) const {
+        if (!isValid() || x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > width || y + h > height) {
+            return {};
+        }
+
+        return {rowPtr(y) + static_cast<size_t>(x) * channels, w, h, channels, stride};
+    }
+
+    std::array<uint8_t, 3> ImageView::getRGB(int x, int y) const {
+        if (!isValid()) throw std::runtime_error("[ImageView::getRGB] Invalid view");
+        if (x < 0 || x >= width || y < 0 || y >= height)
+            throw std::out_of_range("[ImageView::getRGB] Out of bounds");
+
+        const uint8_t *px = rowPtr(y) + static_cast<size_t>(x) * channels;
+
+        if (channels < 3) {
+            return {px[0], px[0], px[0]};
+        }
+
+        return {px[0], px[1], px[2]};
+    }
+
+    cv::Mat ImageView::mat() const {
+        if (!isValid())
+            throw std::runtime_error("[ImageView::mat] Invalid view");
+
+        return {height, width, CV_8UC(channels), const_cast<uint8_t *>(pixels), stride};
+    }
+
+    Image ImageView::toImage(bool alignRows) const {
+        if (!isValid()) return Image();
+
+        const size_t rowBytes = static_cast<size_t>(width) * channels;
+
+        Image out = Image::allocate(width, height, channels, alignRows);
+        out.origin = "view";
+
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(out.rowPtr(y), rowPtr(y), rowBytes);
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,60 @@
+#include "LibGraphics/IntegralImage.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace LibGraphics {
+
+    IntegralImage::IntegralImage(cv::Mat sum, cv::Mat squaredSum)
+        : sum_(std::move(sum)), squaredSum_(std::move(squaredSum)) {}
+
+    Rect IntegralImage::clip(const Rect &rect, int channel, const char *caller) const {
+        if (channel < 0 || channel >= channels())
+            throw std::out_of_range(std::string("[IntegralImage::") + caller + "] Channel out of range");
+
+        return rect.intersect(Rect{0, 0, width(), height()});
+    }
+
+    double IntegralImage::boxSum(const cv::Mat &table, const Rect &clipped, int channel) {
+        const int cn = table.channels();
+        const double *top = table.ptr<double>(clipped.Y);
+        const double *bottom = table.ptr<double>(clipped.Y + clipped.Height);
+        const int left = clipped.X * cn + channel;
+        const int right = (clipped.X + clipped.Width) * cn + channel;
+
+        return bottom[right] - bottom[left] - top[right] + top[left];
+    }
+
+    double IntegralImage::sum(const Rect &rect, int channel) const {
+        const Rect r = clip(rect, channel, "sum");
+        return r.area() > 0 ? boxSum(sum_, r, channel) : 0.0;
+    }
+
+    double IntegralImage::squaredSum(const Rect &rect, int channel) const {
+        const Rect r = clip(rect, channel, "squaredSum");
+        return r.area() > 0 ? boxSum(squaredSum_, r, channel) : 0.0;
+    }
+
+    double IntegralImage::mean(const Rect &rect, int channel) const {
+        const Rect r = clip(rect, channel, "mean");
+        return r.area() > 0 ? boxSum(sum_, r, channel) / r.area() : 0.0;
+    }
+
+    double IntegralImage::variance(const Rect &rect, int channel) const {
+        const Rect r = clip(rect, channel, "variance");
+        if (r.area() <= 0) return 0.0;
+
+        const double n = r.area();
+        const double m = boxSum(sum_, r, channel) / n;
+
+        // E[x^2] - E[x]^2 can dip just below zero on flat regions.
+        return std::max(0.0, boxSum(squaredSum_, r, channel) / n - m * m);
+    }
+
+    double IntegralImage::stddev(const Rect &rect, int channel) const {
+        return std::sqrt(variance(rect, channel));
+    }
+}
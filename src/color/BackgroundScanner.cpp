@@ -2,16 +2,43 @@
 
 #include <iostream>
 #include <cstdint>
+#include <stdexcept>
 
 namespace LibGraphics::Color {
-    int BackgroundScanner::background_color_change_up(const std::vector<std::vector<uint8_t> > &image,
-                                                      int start_x, int start_y, int max_attempts, bool debug) {
+    // The scans read pixels through `image(y, x)`, so vectors and images are walked in place.
+    namespace {
+        struct MatrixPixels {
+            const std::vector<std::vector<uint8_t>> &matrix;
+
+            [[nodiscard]] int rows() const { return static_cast<int>(matrix.size()); }
+            [[nodiscard]] int cols() const { return static_cast<int>(matrix[0].size()); }
+            uint8_t operator()(int y, int x) const { return matrix[y][x]; }
+        };
+
+        // Only the first channel (red, or gray) is compared.
+        struct FirstChannel {
+            const ImageView &view;
+
+            [[nodiscard]] int rows() const { return view.height; }
+            [[nodiscard]] int cols() const { return view.width; }
+            uint8_t operator()(int y, int x) const { return view.rowPtr(y)[static_cast<size_t>(x) * view.channels]; }
+        };
+
+        FirstChannel firstChannel(const ImageView &view) {
+            if (!view)
+                throw std::runtime_error("[BackgroundScanner] Invalid image");
+            return FirstChannel{view};
+        }
+    }
+
+    template <typename Pixels>
+    static int scan_up(const Pixels &image, int start_x, int start_y, int max_attempts, bool debug) {
         const auto empty = std::make_tuple(0, 0, 0);
         auto last = empty;
         int y = start_y;
         int step = 0;
 
-        auto ret = std::make_tuple(image[y][start_x], image[y][start_x], image[y][start_x]);
+        auto ret = std::make_tuple(image(y, start_x), image(y, start_x), image(y, start_x));
         last = ret;
 
         for (int attempt = 0; attempt < max_attempts; ++attempt) {
@@ -26,7 +53,7 @@ namespace LibGraphics::Color {
                 std::cerr << "background_color_change_up x: " << start_x << " y: " << y << "\n";
             }
 
-            auto ret = std::make_tuple(image[y][start_x], image[y][start_x], image[y][start_x]);
+            auto ret = std::make_tuple(image(y, start_x), image(y, start_x), image(y, start_x));
 
             if (last != empty && ret != last) {
                 return step;
@@ -39,15 +66,15 @@ namespace LibGraphics::Color {
     }
 
 
-    int BackgroundScanner::background_color_change_down(const std::vector<std::vector<uint8_t> > &image,
-                                                        int start_x, int start_y, int max_attempts, bool debug) {
+    template <typename Pixels>
+    static int scan_down(const Pixels &image, int start_x, int start_y, int max_attempts, bool debug) {
         const auto empty = std::make_tuple(0, 0, 0);
         auto last = empty;
         int step = 0;
         int y = start_y;
-        int height = ((int) image.size() - 1); // -1 is to change it from human-readable to an index.
+        int height = (image.rows() - 1); // -1 is to change it from human-readable to an index.
 
-        auto ret = std::make_tuple(image[y][start_x], image[y][start_x], image[y][start_x]);
+        auto ret = std::make_tuple(image(y, start_x), image(y, start_x), image(y, start_x));
         last = ret;
 
         for (int attempt = 0; attempt < max_attempts; ++attempt) {
@@ -62,7 +89,7 @@ namespace LibGraphics::Color {
                 std::cerr << "background_color_change_down x: " << start_x << " y: " << y << "\n";
             }
 
-            auto ret = std::make_tuple(image[y][start_x], image[y][start_x], image[y][start_x]);
+            auto ret = std::make_tuple(image(y, start_x), image(y, start_x), image(y, start_x));
 
             if (last != empty && ret != last) {
                 return step;
@@ -74,13 +101,13 @@ namespace LibGraphics::Color {
         return -1;
     }
 
-    int BackgroundScanner::background_color_change_left(const std::vector<std::vector<uint8_t> > &image,
-                                                        int start_x, int start_y, int max_attempts, bool debug) {
+    template <typename Pixels>
+    static int scan_left(const Pixels &image, int start_x, int start_y, int max_attempts, bool debug) {
         const auto empty = std::make_tuple(0, 0, 0);
         auto last = empty;
         int step = 0;
 
-        auto ret = std::make_tuple(image[start_y][start_x], image[start_y][start_x], image[start_y][start_x]);
+        auto ret = std::make_tuple(image(start_y, start_x), image(start_y, start_x), image(start_y, start_x));
         last = ret;
 
         for (int attempt = 0; attempt < max_attempts; ++attempt) {
@@ -96,7 +123,7 @@ namespace LibGraphics::Color {
                         "\n";
             }
 
-            auto ret = std::make_tuple(image[start_y][start_x], image[start_y][start_x], image[start_y][start_x]);
+            auto ret = std::make_tuple(image(start_y, start_x), image(start_y, start_x), image(start_y, start_x));
 
             if (last != empty && ret != last) {
                 return step;
@@ -108,17 +135,17 @@ namespace LibGraphics::Color {
         return -1;
     }
 
-    int BackgroundScanner::background_color_change_right(const std::vector<std::vector<uint8_t> > &image,
-                                                         int start_x, int start_y, int max_attempts, bool debug) {
+    template <typename Pixels>
+    static int scan_right(const Pixels &image, int start_x, int start_y, int max_attempts, bool debug) {
         const auto empty = std::make_tuple(0, 0, 0);
         auto last = empty;
 
-        int height = (int) image.size();
-        int width = (int) image[0].size();
+        int height = image.rows();
+        int width = image.cols();
         int step = 0;
 
         // last need to be set
-        auto ret = std::make_tuple(image[start_y][start_x], image[start_y][start_x], image[start_y][start_x]);
+        auto ret = std::make_tuple(image(start_y, start_x), image(start_y, start_x), image(start_y, start_x));
         last = ret;
 
         for (int attempt = 0; attempt < max_attempts; ++attempt) {
@@ -133,7 +160,7 @@ namespace LibGraphics::Color {
                 std::cerr << "background_color_change_right x: " << start_x << " y: " << start_y << "\n";
             }
 
-            auto ret = std::make_tuple(image[start_y][start_x], image[start_y][start_x], image[start_y][start_x]);
+            auto ret = std::make_tuple(image(start_y, start_x), image(start_y, start_x), image(start_y, start_x));
 
             if (last != empty && ret != last) {
                 return step;
@@ -148,15 +175,68 @@ namespace LibGraphics::Color {
 
     // wrappers
 
-    static std::vector<std::vector<uint8_t>> toMatrix(const Image& img) {
-        std::vector<std::vector<uint8_t>> matrix(img.height, std::vector<uint8_t>(img.width));
-        for (int y = 0; y < img.height; ++y) {
-            for (int x = 0; x < img.width; ++x) {
-                int idx = (y * img.width + x) * img.channels;
-                matrix[y][x] = img.data[idx]; // take first channel (e.g. red or gray)
-            }
-        }
-        return matrix;
+    int BackgroundScanner::background_color_change_up(const std::vector<std::vector<uint8_t> > &image,
+                                                      int start_x,
+                                                      int start_y,
+                                                      int max_attempts,
+                                                      bool debug) {
+        return scan_up(MatrixPixels{image}, start_x, start_y, max_attempts, debug);
+    }
+
+    int BackgroundScanner::background_color_change_up(const ImageView &img,
+                                                      int start_x,
+                                                      int start_y,
+                                                      int max_attempts,
+                                                      bool debug) {
+        return scan_up(firstChannel(img), start_x, start_y, max_attempts, debug);
+    }
+
+    int BackgroundScanner::background_color_change_down(const std::vector<std::vector<uint8_t> > &image,
+                                                        int start_x,
+                                                        int start_y,
+                                                        int max_attempts,
+                                                        bool debug) {
+        return scan_down(MatrixPixels{image}, start_x, start_y, max_attempts, debug);
+    }
+
+    int BackgroundScanner::background_color_change_down(const ImageView &img,
+                                                        int start_x,
+                                                        int start_y,
+                                                        int max_attempts,
+                                                        bool debug) {
+        return scan_down(firstChannel(img), start_x, start_y, max_attempts, debug);
+    }
+
+    int BackgroundScanner::background_color_change_left(const std::vector<std::vector<uint8_t> > &image,
+                                                        int start_x,
+                                                        int start_y,
+                                                        int max_attempts,
+                                                        bool debug) {
+        return scan_left(MatrixPixels{image}, start_x, start_y, max_attempts, debug);
+    }
+
+    int BackgroundScanner::background_color_change_left(const ImageView &img,
+                                                        int start_x,
+                                                        int start_y,
+                                                        int max_attempts,
+                                                        bool debug) {
+        return scan_left(firstChannel(img), start_x, start_y, max_attempts, debug);
+    }
+
+    int BackgroundScanner::background_color_change_right(const std::vector<std::vector<uint8_t> > &image,
+                                                         int start_x,
+                                                         int start_y,
+                                                         int max_attempts,
+                                                         bool debug) {
+        return scan_right(MatrixPixels{image}, start_x, start_y, max_attempts, debug);
+    }
+
+    int BackgroundScanner::background_color_change_right(const ImageView &img,
+                                                         int start_x,
+                                                         int start_y,
+                                                         int max_attempts,
+                                                         bool debug) {
+        return scan_right(firstChannel(img), start_x, start_y, max_attempts, debug);
     }
 
     int BackgroundScanner::background_color_change_up(const Image &img,
@@ -164,7 +244,7 @@ namespace LibGraphics::Color {
                                                       int start_y,
                                                       int max_attempts,
                                                       bool debug) {
-        return background_color_change_up(toMatrix(img), start_x, start_y, max_attempts, debug);
+        return background_color_change_up(img.view(), start_x, start_y, max_attempts, debug);
     }
 
     int BackgroundScanner::background_color_change_down(const Image &img,
@@ -172,7 +252,7 @@ namespace LibGraphics::Color {
                                                         int start_y,
                                                         int max_attempts,
                                                         bool debug) {
-        return background_color_change_down(toMatrix(img), start_x, start_y, max_attempts, debug);
+        return background_color_change_down(img.view(), start_x, start_y, max_attempts, debug);
     }
 
     int BackgroundScanner::background_color_change_left(const Image &img,
@@ -180,7 +260,7 @@ namespace LibGraphics::Color {
                                                         int start_y,
                                                         int max_attempts,
                                                         bool debug) {
-        return background_color_change_left(toMatrix(img), start_x, start_y, max_attempts, debug);
+        return background_color_change_left(img.view(), start_x, start_y, max_attempts, debug);
     }
 
     int BackgroundScanner::background_color_change_right(const Image &img,
@@ -188,6 +268,6 @@ namespace LibGraphics::Color {
                                                          int start_y,
                                                          int max_attempts,
                                                          bool debug) {
-        return background_color_change_right(toMatrix(img), start_x, start_y, max_attempts, debug);
+        return background_color_change_right(img.view(), start_x, start_y, max_attempts, debug);
     }
 }
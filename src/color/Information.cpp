@@ -1,6 +1,9 @@
 #include "LibGraphics/color/Information.hpp"
 
+#include <opencv2/core.hpp>
+
 #include <algorithm>
+#include <stdexcept>
 
 namespace LibGraphics::Color {
     bool Information::is_greenish(int r, int g, int b, int buffer) {
@@ -25,4 +28,48 @@ namespace LibGraphics::Color {
                chroma_diff <= 10;
     }
 
+    // Gray images have a single plane; treat it as R = G = B like is_white(v, v, v) would.
+    static const cv::Mat& channelPlane(const Image& image, int channel) {
+        return image.plane(image.channels >= 3 ? channel : 0);
+    }
+
+    cv::Mat Information::greenish_mask(const Image& image, int buffer) {
+        if (!image.isValid())
+            throw std::runtime_error("[Information::greenish_mask] Invalid image");
+
+        constexpr int target[3] = {112, 141, 0};
+
+        cv::Mat mask, channel;
+        for (int c = 0; c < 3; ++c) {
+            cv::inRange(channelPlane(image, c), cv::Scalar(target[c] - buffer), cv::Scalar(target[c] + buffer),
+                        c == 0 ? mask : channel);
+            if (c != 0) cv::bitwise_and(mask, channel, mask);
+        }
+        return mask;
+    }
+
+    cv::Mat Information::white_mask(const Image& image, int threshold) {
+        if (!image.isValid())
+            throw std::runtime_error("[Information::white_mask] Invalid image");
+
+        const cv::Mat& r = channelPlane(image, 0);
+        const cv::Mat& g = channelPlane(image, 1);
+        const cv::Mat& b = channelPlane(image, 2);
+
+        cv::Mat lowest, highest;
+        cv::min(r, g, lowest);
+        cv::min(lowest, b, lowest);
+        cv::max(r, g, highest);
+        cv::max(highest, b, highest);
+
+        // The brightness check in is_white() follows from min >= threshold.
+        cv::Mat bright, flat;
+        cv::compare(lowest, cv::Scalar(threshold), bright, cv::CMP_GE);
+        cv::subtract(highest, lowest, highest);
+        cv::compare(highest, cv::Scalar(10), flat, cv::CMP_LE);
+
+        cv::Mat mask;
+        cv::bitwise_and(bright, flat, mask);
+        return mask;
+    }
 }
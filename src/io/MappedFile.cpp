@@ -0,0 +1,102 @@
+#include "LibGraphics/io/MappedFile.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LibGraphics::IO {
+
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string &path) {
+        const std::wstring wide = std::filesystem::path(path).wstring();
+        HANDLE file = CreateFileW(wide.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER length{};
+        if (!GetFileSizeEx(file, &length)) {
+            CloseHandle(file);
+            return;
+        }
+
+        size_ = static_cast<size_t>(length.QuadPart);
+        open_ = true;
+
+        if (size_ > 0) {
+            mappingHandle_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingHandle_) mapping_ = MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0);
+        }
+
+        CloseHandle(file);
+
+        if (mapping_) {
+            data_ = static_cast<const uint8_t *>(mapping_);
+        } else if (size_ > 0) {
+            readFallback(path);
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (mapping_) UnmapViewOfFile(mapping_);
+        if (mappingHandle_) CloseHandle(mappingHandle_);
+    }
+#else
+    MappedFile::MappedFile(const std::string &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return;
+        }
+
+        size_ = static_cast<size_t>(info.st_size);
+        open_ = true;
+
+        if (S_ISREG(info.st_mode) && size_ > 0) {
+            void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (addr != MAP_FAILED) {
+                // Decoders walk the file front to back once; read ahead aggressively and drop pages behind.
+                ::madvise(addr, size_, MADV_SEQUENTIAL);
+                mapping_ = addr;
+                data_ = static_cast<const uint8_t *>(addr);
+            }
+        }
+
+        ::close(fd);
+
+        if (!mapping_ && (size_ > 0 || !S_ISREG(info.st_mode)))
+            readFallback(path);
+    }
+
+    MappedFile::~MappedFile() {
+        if (mapping_) ::munmap(mapping_, size_);
+    }
+#endif
+
+    void MappedFile::readFallback(const std::string &path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            open_ = false;
+            size_ = 0;
+            return;
+        }
+
+        fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = fallback_.data();
+        size_ = fallback_.size();
+    }
+}
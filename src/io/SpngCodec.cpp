@@ -0,0 +1,115 @@
+#include "LibGraphics/io/SpngCodec.hpp"
+
+#include <spng.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace LibGraphics::IO {
+
+    namespace {
+        struct ContextDeleter {
+            void operator()(spng_ctx *ctx) const { spng_ctx_free(ctx); }
+        };
+
+        using Context = std::unique_ptr<spng_ctx, ContextDeleter>;
+
+        int colorTypeFor(int channels) {
+            switch (channels) {
+                case 1: return SPNG_COLOR_TYPE_GRAYSCALE;
+                case 2: return SPNG_COLOR_TYPE_GRAYSCALE_ALPHA;
+                case 3: return SPNG_COLOR_TYPE_TRUECOLOR;
+                case 4: return SPNG_COLOR_TYPE_TRUECOLOR_ALPHA;
+                default: return -1;
+            }
+        }
+    }
+
+    bool isPng(const uint8_t *data, size_t size) {
+        static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        return size >= sizeof(signature) && std::memcmp(data, signature, sizeof(signature)) == 0;
+    }
+
+    DecodedImage decodeSpng(const uint8_t *data, size_t size) {
+        DecodedImage out;
+
+        Context ctx(spng_ctx_new(0));
+        if (!ctx || spng_set_png_buffer(ctx.get(), data, size) != 0) return out;
+
+        spng_ihdr ihdr{};
+        if (spng_get_ihdr(ctx.get(), &ihdr) != 0) return out;
+
+        int format = SPNG_FMT_RGB8;
+        int channels = 3;
+
+        if (ihdr.color_type == SPNG_COLOR_TYPE_GRAYSCALE_ALPHA) return out;
+
+        if (ihdr.color_type == SPNG_COLOR_TYPE_GRAYSCALE) {
+            spng_trns trns{};
+            if (ihdr.bit_depth > 8 || spng_get_trns(ctx.get(), &trns) == 0) return out;
+
+            format = SPNG_FMT_G8;
+            channels = 1;
+        }
+
+        size_t bytes = 0;
+        if (spng_decoded_image_size(ctx.get(), format, &bytes) != 0) return out;
+
+        Type::PixelBuffer pixels = Type::PixelBuffer::uninitialized(bytes);
+        if (spng_decode_image(ctx.get(), pixels.data(), bytes, format, 0) != 0) return out;
+
+        out.pixels = std::move(pixels);
+        out.width = static_cast<int>(ihdr.width);
+        out.height = static_cast<int>(ihdr.height);
+        out.channels = channels;
+        return out;
+    }
+
+    std::vector<uint8_t> encodeSpng(const uint8_t *pixels, int width, int height, int channels, size_t stride, int level) {
+        const int colorType = colorTypeFor(channels);
+        if (colorType < 0) return {};
+
+        Context ctx(spng_ctx_new(SPNG_CTX_ENCODER));
+        if (!ctx) return {};
+
+        spng_set_option(ctx.get(), SPNG_ENCODE_TO_BUFFER, 1);
+        spng_set_option(ctx.get(), SPNG_IMG_COMPRESSION_LEVEL, level);
+
+        spng_ihdr ihdr{};
+        ihdr.width = static_cast<uint32_t>(width);
+        ihdr.height = static_cast<uint32_t>(height);
+        ihdr.bit_depth = 8;
+        ihdr.color_type = static_cast<uint8_t>(colorType);
+
+        const size_t rowBytes = static_cast<size_t>(width) * channels;
+        if (spng_set_ihdr(ctx.get(), &ihdr) != 0) return {};
+
+        if (stride == rowBytes) {
+            if (spng_encode_image(ctx.get(), pixels, rowBytes * height, SPNG_FMT_PNG, SPNG_ENCODE_FINALIZE) != 0)
+                return {};
+        } else {
+            // Padded rows: hand them over one by one instead of packing a copy first.
+            if (spng_encode_image(ctx.get(), nullptr, 0, SPNG_FMT_PNG, SPNG_ENCODE_PROGRESSIVE | SPNG_ENCODE_FINALIZE) != 0)
+                return {};
+
+            int status = 0;
+            for (int y = 0; y < height && status == 0; ++y)
+                status = spng_encode_row(ctx.get(), pixels + static_cast<size_t>(y) * stride, rowBytes);
+
+            if (status != SPNG_EOI) return {};
+        }
+
+        size_t length = 0;
+        int error = 0;
+        void *png = spng_get_png_buffer(ctx.get(), &length, &error);
+        if (!png || error != 0) {
+            std::free(png);
+            return {};
+        }
+
+        std::vector<uint8_t> out(static_cast<uint8_t *>(png), static_cast<uint8_t *>(png) + length);
+        std::free(png);
+        return out;
+    }
+}
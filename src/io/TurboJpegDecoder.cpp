@@ -0,0 +1,80 @@
+#include "LibGraphics/io/TurboJpegDecoder.hpp"
+#include "LibGraphics/memory/PixelAllocator.hpp"
+
+#include <turbojpeg.h>
+
+#include <limits>
+
+namespace LibGraphics::IO {
+
+    namespace {
+        // One decompressor per thread; creating one per image costs more than decoding a thumbnail.
+        struct Decompressor {
+            tjhandle handle = tjInitDecompress();
+
+            ~Decompressor() {
+                if (handle) tjDestroy(handle);
+            }
+        };
+
+        tjhandle decompressor() {
+            static thread_local Decompressor local;
+            return local.handle;
+        }
+
+        bool scalingFactor(int denominator, tjscalingfactor &out) {
+            int count = 0;
+            const tjscalingfactor *factors = tjGetScalingFactors(&count);
+
+            for (int i = 0; factors && i < count; ++i) {
+                if (factors[i].num == 1 && factors[i].denom == denominator) {
+                    out = factors[i];
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    bool isJpeg(const uint8_t *data, size_t size) {
+        return size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF;
+    }
+
+    DecodedImage decodeTurboJpeg(const uint8_t *data, size_t size, const LoadOptions &options) {
+        DecodedImage out;
+
+        tjhandle handle = decompressor();
+        if (!handle || size > std::numeric_limits<unsigned long>::max()) return out;
+
+        const auto length = static_cast<unsigned long>(size);
+
+        int width = 0, height = 0, subsampling = 0, colorspace = 0;
+        if (tjDecompressHeader3(handle, data, length, &width, &height, &subsampling, &colorspace) != 0)
+            return out;
+
+        tjscalingfactor factor{1, 1};
+        if (options.scaleDenominator != 1 && !scalingFactor(options.scaleDenominator, factor))
+            return out;
+
+        out.width = TJSCALED(width, factor);
+        out.height = TJSCALED(height, factor);
+        out.channels = options.grayscale ? 1 : 3;
+
+        // Padded rows come straight out of the decoder through its pitch argument.
+        const size_t rowBytes = static_cast<size_t>(out.width) * out.channels;
+        constexpr size_t alignment = Memory::PixelAllocator::Alignment;
+        const size_t pitch = options.alignRows ? (rowBytes + alignment - 1) / alignment * alignment : rowBytes;
+        out.stride = options.alignRows ? pitch : 0;
+        out.pixels = Type::PixelBuffer::uninitialized(pitch * out.height);
+
+        const int format = options.grayscale ? TJPF_GRAY : TJPF_RGB;
+
+        if (tjDecompress2(handle, data, length, out.pixels.data(), out.width, static_cast<int>(pitch), out.height, format, 0) != 0) {
+            // Warnings (e.g. a truncated tail) still produce a usable image, only hard errors fail.
+            if (tjGetErrorCode(handle) != TJERR_WARNING) return {};
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,119 @@
+#include "LibGraphics/kernels/Channels.hpp"
+
+#if defined(LIBGRAPHICS_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(LIBGRAPHICS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace LibGraphics::Kernels {
+
+    namespace {
+        void stripScalar(const uint8_t *src, uint8_t *dst, size_t from, size_t pixels) {
+            for (size_t i = from; i < pixels; ++i) {
+                const uint8_t r = src[i * 4 + 0];
+                const uint8_t g = src[i * 4 + 1];
+                const uint8_t b = src[i * 4 + 2];
+                dst[i * 3 + 0] = r;
+                dst[i * 3 + 1] = g;
+                dst[i * 3 + 2] = b;
+            }
+        }
+
+#if defined(LIBGRAPHICS_X86)
+        /*
+         * pshufb packs every 16 bytes (4 pixels) into the low 12 bytes of a lane.
+         * The vector stores are wider than the 12 * lanes bytes they produce; the
+         * loop bounds keep the spill inside the 3 * pixels output, and since the
+         * output trails the input (3i vs 4i) it only ever lands on bytes that are
+         * already consumed or still to be overwritten.
+         */
+        alignas(16) const int8_t CompactMask[16] = {0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1};
+
+        LIBGRAPHICS_TARGET("sse4.1")
+        size_t stripSSE(const uint8_t *src, uint8_t *dst, size_t pixels) {
+            const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i *>(CompactMask));
+
+            size_t i = 0;
+            for (; i + 6 <= pixels; i += 4) {
+                const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 3), _mm_shuffle_epi8(px, mask));
+            }
+
+            return i;
+        }
+
+        LIBGRAPHICS_TARGET("avx2")
+        size_t stripAVX2(const uint8_t *src, uint8_t *dst, size_t pixels) {
+            const __m256i mask = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(CompactMask)));
+            const __m256i join = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+            size_t i = 0;
+            for (; i + 11 <= pixels; i += 8) {
+                const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 4));
+                const __m256i rgb = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(px, mask), join);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 3), rgb);
+            }
+
+            return i + stripSSE(src + i * 4, dst + i * 3, pixels - i);
+        }
+
+        LIBGRAPHICS_TARGET("avx512f,avx512bw")
+        size_t stripAVX512(const uint8_t *src, uint8_t *dst, size_t pixels) {
+            const __m512i mask = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i *>(CompactMask)));
+            const __m512i join = _mm512_setr_epi32(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 3, 7, 11, 15);
+            const __mmask64 rgbBytes = (__mmask64(1) << 48) - 1;
+
+            size_t i = 0;
+            for (; i + 16 <= pixels; i += 16) {
+                const __m512i px = _mm512_loadu_si512(reinterpret_cast<const void *>(src + i * 4));
+                const __m512i rgb = _mm512_permutexvar_epi32(join, _mm512_shuffle_epi8(px, mask));
+                _mm512_mask_storeu_epi8(dst + i * 3, rgbBytes, rgb);
+            }
+
+            return i + stripAVX2(src + i * 4, dst + i * 3, pixels - i);
+        }
+#endif
+
+#if defined(LIBGRAPHICS_NEON)
+        size_t stripNEON(const uint8_t *src, uint8_t *dst, size_t pixels) {
+            size_t i = 0;
+            for (; i + 16 <= pixels; i += 16) {
+                const uint8x16x4_t px = vld4q_u8(src + i * 4);
+                uint8x16x3_t rgb;
+                rgb.val[0] = px.val[0];
+                rgb.val[1] = px.val[1];
+                rgb.val[2] = px.val[2];
+                vst3q_u8(dst + i * 3, rgb);
+            }
+
+            return i;
+        }
+#endif
+    }
+
+    void stripAlpha(Backend backend, const uint8_t *src, uint8_t *dst, size_t pixels) {
+        size_t done = 0;
+
+        switch (backend) {
+#if defined(LIBGRAPHICS_X86)
+            case Backend::SSE41: done = stripSSE(src, dst, pixels); break;
+            case Backend::AVX2: done = stripAVX2(src, dst, pixels); break;
+            case Backend::AVX512: done = stripAVX512(src, dst, pixels); break;
+#endif
+#if defined(LIBGRAPHICS_NEON)
+            case Backend::NEON: done = stripNEON(src, dst, pixels); break;
+#endif
+            default: break;
+        }
+
+        stripScalar(src, dst, done, pixels);
+    }
+
+    void stripAlpha(const uint8_t *src, uint8_t *dst, size_t pixels) {
+        static const Backend backend = bestBackend();
+        stripAlpha(backend, src, dst, pixels);
+    }
+}
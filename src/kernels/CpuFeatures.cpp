@@ -0,0 +1,111 @@
+#include "LibGraphics/kernels/CpuFeatures.hpp"
+
+#if defined(LIBGRAPHICS_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#include <cstdlib>
+#include <cstring>
+
+namespace LibGraphics::Kernels {
+
+    namespace {
+        struct Features {
+            bool sse41 = false;
+            bool avx2 = false;
+            bool avx512 = false;
+            bool neon = false;
+        };
+
+        Features detect() {
+            Features f;
+
+#if defined(LIBGRAPHICS_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            f.sse41 = __builtin_cpu_supports("sse4.1");
+            f.avx2 = __builtin_cpu_supports("avx2");
+            f.avx512 = __builtin_cpu_supports("avx512bw");
+#elif defined(LIBGRAPHICS_X86) && defined(_MSC_VER)
+            int info[4] = {};
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+
+            __cpuid(info, 1);
+            f.sse41 = (info[2] & (1 << 19)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            const bool ymmState = (xcr0 & 0x6) == 0x6;
+            const bool zmmState = (xcr0 & 0xe6) == 0xe6;
+
+            if (maxLeaf >= 7) {
+                __cpuidex(info, 7, 0);
+                f.avx2 = ymmState && (info[1] & (1 << 5)) != 0;
+                f.avx512 = zmmState && (info[1] & (1 << 30)) != 0;
+            }
+#endif
+
+#if defined(LIBGRAPHICS_NEON)
+            f.neon = true;
+#endif
+
+            // LIBGRAPHICS_SIMD=scalar|sse41|avx2 caps the dispatch, handy for comparing paths.
+            if (const char *cap = std::getenv("LIBGRAPHICS_SIMD")) {
+                if (std::strcmp(cap, "scalar") == 0) f = Features();
+                if (std::strcmp(cap, "sse41") == 0) f.avx2 = f.avx512 = false;
+                if (std::strcmp(cap, "avx2") == 0) f.avx512 = false;
+            }
+
+            return f;
+        }
+
+        const Features &features() {
+            static const Features cached = detect();
+            return cached;
+        }
+    }
+
+    bool isSupported(Backend backend) {
+        const Features &f = features();
+
+        switch (backend) {
+            case Backend::Scalar: return true;
+            case Backend::SSE41: return f.sse41;
+            case Backend::AVX2: return f.avx2;
+            case Backend::AVX512: return f.avx512;
+            case Backend::NEON: return f.neon;
+        }
+
+        return false;
+    }
+
+    Backend bestBackend() {
+        for (Backend backend: {Backend::AVX512, Backend::AVX2, Backend::SSE41, Backend::NEON}) {
+            if (isSupported(backend)) return backend;
+        }
+
+        return Backend::Scalar;
+    }
+
+    std::vector<Backend> supportedBackends() {
+        std::vector<Backend> out;
+
+        for (Backend backend: {Backend::Scalar, Backend::SSE41, Backend::AVX2, Backend::AVX512, Backend::NEON}) {
+            if (isSupported(backend)) out.push_back(backend);
+        }
+
+        return out;
+    }
+
+    const char *backendName(Backend backend) {
+        switch (backend) {
+            case Backend::Scalar: return "scalar";
+            case Backend::SSE41: return "sse4.1";
+            case Backend::AVX2: return "avx2";
+            case Backend::AVX512: return "avx512bw";
+            case Backend::NEON: return "neon";
+        }
+
+        return "unknown";
+    }
+}
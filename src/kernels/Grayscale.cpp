@@ -0,0 +1,345 @@
+#include "LibGraphics/kernels/Grayscale.hpp"
+#include "LibGraphics/kernels/Dispatch.hpp"
+
+#if defined(LIBGRAPHICS_X86)
+#include <immintrin.h>
+#endif
+
+#if defined(LIBGRAPHICS_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <cstring>
+
+namespace LibGraphics::Kernels {
+
+    namespace {
+        struct Weights {
+            int first;
+            int second;
+            int third;
+        };
+
+        Weights weightsFor(ChannelOrder order) {
+            if (order == ChannelOrder::BGR) return {GrayWeightB, GrayWeightG, GrayWeightR};
+            return {GrayWeightR, GrayWeightG, GrayWeightB};
+        }
+
+        template <int Channels>
+        void rowScalarFixed(const uint8_t *src, uint8_t *dst, int from, int width, const Weights &w) {
+            const uint8_t *px = src + static_cast<size_t>(from) * Channels;
+
+            if constexpr (Channels == 1) {
+                std::memcpy(dst + from, px, static_cast<size_t>(width - from));
+            } else if constexpr (Channels == 2) {
+                // Gray plus alpha: the luma is already there.
+                for (int x = from; x < width; ++x, px += Channels) dst[x] = px[0];
+            } else {
+                for (int x = from; x < width; ++x, px += Channels) {
+                    dst[x] = static_cast<uint8_t>((px[0] * w.first + px[1] * w.second + px[2] * w.third + GrayRound) >> GrayShift);
+                }
+            }
+        }
+
+        void rowScalar(const uint8_t *src, uint8_t *dst, int from, int width, int channels, const Weights &w) {
+            dispatchChannels(channels, [&](auto c) { rowScalarFixed<decltype(c)::value>(src, dst, from, width, w); });
+        }
+
+#if defined(LIBGRAPHICS_X86)
+        /*
+         * The x86 paths widen to 16 bits and use pmaddwd on (c0, c1) and (c2, 1)
+         * pairs, so the rounding constant rides along as the fourth "weight" and
+         * every lane computes exactly the scalar Q15 expression.
+         *
+         * 3-channel pixels are split into planes 16 at a time with pshufb: each
+         * 16-byte chunk of 48 contributes the bytes of one plane it holds and the
+         * three partial results are OR-ed together.
+         */
+        alignas(16) const int8_t DeinterleaveMasks[3][3][16] = {
+            {   // first channel
+                {0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+                {-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1},
+                {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13},
+            },
+            {   // second channel
+                {1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+                {-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1},
+                {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14},
+            },
+            {   // third channel
+                {2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+                {-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1},
+                {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15},
+            },
+        };
+
+        inline int pairWeights(int lo, int hi) {
+            return static_cast<int>((static_cast<uint32_t>(hi) << 16) | static_cast<uint32_t>(lo & 0xffff));
+        }
+
+        LIBGRAPHICS_TARGET("sse4.1")
+        __m128i lumaSSE(__m128i c0, __m128i c1, __m128i c2, __m128i w01, __m128i w2r) {
+            const __m128i one = _mm_set1_epi16(1);
+            const __m128i p01 = _mm_madd_epi16(_mm_unpacklo_epi16(c0, c1), w01);
+            const __m128i p2 = _mm_madd_epi16(_mm_unpacklo_epi16(c2, one), w2r);
+            const __m128i q01 = _mm_madd_epi16(_mm_unpackhi_epi16(c0, c1), w01);
+            const __m128i q2 = _mm_madd_epi16(_mm_unpackhi_epi16(c2, one), w2r);
+
+            return _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(p01, p2), GrayShift),
+                                   _mm_srai_epi32(_mm_add_epi32(q01, q2), GrayShift));
+        }
+
+        LIBGRAPHICS_TARGET("sse4.1")
+        int row4SSE(const uint8_t *src, uint8_t *dst, int width, const Weights &w) {
+            // (c0, c1, c2, alpha) pairs: madd gives c0*w0 + c1*w1 and c2*w2 + 0, hadd joins them.
+            const __m128i weights = _mm_setr_epi16(w.first, w.second, w.third, 0, w.first, w.second, w.third, 0);
+            const __m128i round = _mm_set1_epi32(GrayRound);
+            const __m128i zero = _mm_setzero_si128();
+
+            int x = 0;
+            for (; x + 8 <= width; x += 8) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * 4));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * 4 + 16));
+
+                const __m128i sa = _mm_hadd_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(a, zero), weights),
+                                                  _mm_madd_epi16(_mm_unpackhi_epi8(a, zero), weights));
+                const __m128i sb = _mm_hadd_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(b, zero), weights),
+                                                  _mm_madd_epi16(_mm_unpackhi_epi8(b, zero), weights));
+
+                const __m128i luma = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(sa, round), GrayShift),
+                                                     _mm_srai_epi32(_mm_add_epi32(sb, round), GrayShift));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + x), _mm_packus_epi16(luma, luma));
+            }
+
+            return x;
+        }
+
+        LIBGRAPHICS_TARGET("sse4.1")
+        int rowSSE(const uint8_t *src, uint8_t *dst, int width, int channels, const Weights &w) {
+            if (channels == 4) return row4SSE(src, dst, width, w);
+
+            const __m128i w01 = _mm_set1_epi32(pairWeights(w.first, w.second));
+            const __m128i w2r = _mm_set1_epi32(pairWeights(w.third, GrayRound));
+            const __m128i zero = _mm_setzero_si128();
+
+            __m128i masks[3][3];
+            for (int c = 0; c < 3; ++c)
+                for (int part = 0; part < 3; ++part)
+                    masks[c][part] = _mm_load_si128(reinterpret_cast<const __m128i *>(DeinterleaveMasks[c][part]));
+
+            int x = 0;
+            for (; x + 16 <= width; x += 16) {
+                const uint8_t *px = src + x * 3;
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(px));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(px + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(px + 32));
+
+                __m128i planes[3];
+                for (int ch = 0; ch < 3; ++ch) {
+                    planes[ch] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, masks[ch][0]), _mm_shuffle_epi8(b, masks[ch][1])),
+                                              _mm_shuffle_epi8(c, masks[ch][2]));
+                }
+
+                const __m128i lo = lumaSSE(_mm_cvtepu8_epi16(planes[0]), _mm_cvtepu8_epi16(planes[1]),
+                                           _mm_cvtepu8_epi16(planes[2]), w01, w2r);
+                const __m128i hi = lumaSSE(_mm_unpackhi_epi8(planes[0], zero), _mm_unpackhi_epi8(planes[1], zero),
+                                           _mm_unpackhi_epi8(planes[2], zero), w01, w2r);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_packus_epi16(lo, hi));
+            }
+
+            return x;
+        }
+
+        // Lane 0 holds pixels 0-15 and lane 1 pixels 16-31, so the in-lane shuffles and packs never cross.
+        LIBGRAPHICS_TARGET("avx2")
+        __m256i loadLanesAVX2(const uint8_t *p) {
+            return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))),
+                                           _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 48)), 1);
+        }
+
+        LIBGRAPHICS_TARGET("avx2")
+        __m256i lumaAVX2(__m256i c0, __m256i c1, __m256i c2, __m256i w01, __m256i w2r) {
+            const __m256i one = _mm256_set1_epi16(1);
+            const __m256i p01 = _mm256_madd_epi16(_mm256_unpacklo_epi16(c0, c1), w01);
+            const __m256i p2 = _mm256_madd_epi16(_mm256_unpacklo_epi16(c2, one), w2r);
+            const __m256i q01 = _mm256_madd_epi16(_mm256_unpackhi_epi16(c0, c1), w01);
+            const __m256i q2 = _mm256_madd_epi16(_mm256_unpackhi_epi16(c2, one), w2r);
+
+            return _mm256_packs_epi32(_mm256_srai_epi32(_mm256_add_epi32(p01, p2), GrayShift),
+                                      _mm256_srai_epi32(_mm256_add_epi32(q01, q2), GrayShift));
+        }
+
+        LIBGRAPHICS_TARGET("avx2")
+        int rowAVX2(const uint8_t *src, uint8_t *dst, int width, int channels, const Weights &w) {
+            if (channels == 4) return row4SSE(src, dst, width, w);
+
+            const __m256i w01 = _mm256_set1_epi32(pairWeights(w.first, w.second));
+            const __m256i w2r = _mm256_set1_epi32(pairWeights(w.third, GrayRound));
+            const __m256i zero = _mm256_setzero_si256();
+
+            __m256i masks[3][3];
+            for (int c = 0; c < 3; ++c)
+                for (int part = 0; part < 3; ++part)
+                    masks[c][part] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(DeinterleaveMasks[c][part])));
+
+            int x = 0;
+            for (; x + 32 <= width; x += 32) {
+                const uint8_t *px = src + x * 3;
+                const __m256i a = loadLanesAVX2(px);
+                const __m256i b = loadLanesAVX2(px + 16);
+                const __m256i c = loadLanesAVX2(px + 32);
+
+                __m256i planes[3];
+                for (int ch = 0; ch < 3; ++ch) {
+                    planes[ch] = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, masks[ch][0]), _mm256_shuffle_epi8(b, masks[ch][1])),
+                                                 _mm256_shuffle_epi8(c, masks[ch][2]));
+                }
+
+                const __m256i lo = lumaAVX2(_mm256_unpacklo_epi8(planes[0], zero), _mm256_unpacklo_epi8(planes[1], zero),
+                                            _mm256_unpacklo_epi8(planes[2], zero), w01, w2r);
+                const __m256i hi = lumaAVX2(_mm256_unpackhi_epi8(planes[0], zero), _mm256_unpackhi_epi8(planes[1], zero),
+                                            _mm256_unpackhi_epi8(planes[2], zero), w01, w2r);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), _mm256_packus_epi16(lo, hi));
+            }
+
+            return x + rowSSE(src + x * 3, dst + x, width - x, channels, w);
+        }
+
+        // Lane k holds pixels 16k to 16k+15, the AVX2 layout with four lanes.
+        LIBGRAPHICS_TARGET("avx512f,avx512bw")
+        __m512i loadLanesAVX512(const uint8_t *p) {
+            __m512i v = _mm512_castsi128_si512(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 48)), 1);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 96)), 2);
+            return _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 144)), 3);
+        }
+
+        LIBGRAPHICS_TARGET("avx512f,avx512bw")
+        __m512i lumaAVX512(__m512i c0, __m512i c1, __m512i c2, __m512i w01, __m512i w2r) {
+            const __m512i one = _mm512_set1_epi16(1);
+            const __m512i p01 = _mm512_madd_epi16(_mm512_unpacklo_epi16(c0, c1), w01);
+            const __m512i p2 = _mm512_madd_epi16(_mm512_unpacklo_epi16(c2, one), w2r);
+            const __m512i q01 = _mm512_madd_epi16(_mm512_unpackhi_epi16(c0, c1), w01);
+            const __m512i q2 = _mm512_madd_epi16(_mm512_unpackhi_epi16(c2, one), w2r);
+
+            return _mm512_packs_epi32(_mm512_srai_epi32(_mm512_add_epi32(p01, p2), GrayShift),
+                                      _mm512_srai_epi32(_mm512_add_epi32(q01, q2), GrayShift));
+        }
+
+        LIBGRAPHICS_TARGET("avx512f,avx512bw")
+        int rowAVX512(const uint8_t *src, uint8_t *dst, int width, int channels, const Weights &w) {
+            if (channels == 4) return row4SSE(src, dst, width, w);
+
+            const __m512i w01 = _mm512_set1_epi32(pairWeights(w.first, w.second));
+            const __m512i w2r = _mm512_set1_epi32(pairWeights(w.third, GrayRound));
+            const __m512i zero = _mm512_setzero_si512();
+
+            __m512i masks[3][3];
+            for (int c = 0; c < 3; ++c)
+                for (int part = 0; part < 3; ++part)
+                    masks[c][part] = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i *>(DeinterleaveMasks[c][part])));
+
+            int x = 0;
+            for (; x + 64 <= width; x += 64) {
+                const uint8_t *px = src + x * 3;
+                const __m512i a = loadLanesAVX512(px);
+                const __m512i b = loadLanesAVX512(px + 16);
+                const __m512i c = loadLanesAVX512(px + 32);
+
+                __m512i planes[3];
+                for (int ch = 0; ch < 3; ++ch) {
+                    planes[ch] = _mm512_or_si512(_mm512_or_si512(_mm512_shuffle_epi8(a, masks[ch][0]), _mm512_shuffle_epi8(b, masks[ch][1])),
+                                                 _mm512_shuffle_epi8(c, masks[ch][2]));
+                }
+
+                const __m512i lo = lumaAVX512(_mm512_unpacklo_epi8(planes[0], zero), _mm512_unpacklo_epi8(planes[1], zero),
+                                              _mm512_unpacklo_epi8(planes[2], zero), w01, w2r);
+                const __m512i hi = lumaAVX512(_mm512_unpackhi_epi8(planes[0], zero), _mm512_unpackhi_epi8(planes[1], zero),
+                                              _mm512_unpackhi_epi8(planes[2], zero), w01, w2r);
+
+                _mm512_storeu_si512(reinterpret_cast<void *>(dst + x), _mm512_packus_epi16(lo, hi));
+            }
+
+            return x + rowAVX2(src + x * 3, dst + x, width - x, channels, w);
+        }
+#endif
+
+#if defined(LIBGRAPHICS_NEON)
+        uint8x8_t lumaNEON(uint8x8_t c0, uint8x8_t c1, uint8x8_t c2, const Weights &w) {
+            const uint16x8_t a = vmovl_u8(c0);
+            const uint16x8_t b = vmovl_u8(c1);
+            const uint16x8_t c = vmovl_u8(c2);
+
+            uint32x4_t lo = vmull_n_u16(vget_low_u16(a), static_cast<uint16_t>(w.first));
+            lo = vmlal_n_u16(lo, vget_low_u16(b), static_cast<uint16_t>(w.second));
+            lo = vmlal_n_u16(lo, vget_low_u16(c), static_cast<uint16_t>(w.third));
+
+            uint32x4_t hi = vmull_n_u16(vget_high_u16(a), static_cast<uint16_t>(w.first));
+            hi = vmlal_n_u16(hi, vget_high_u16(b), static_cast<uint16_t>(w.second));
+            hi = vmlal_n_u16(hi, vget_high_u16(c), static_cast<uint16_t>(w.third));
+
+            // vrshrn adds 1 << (GrayShift - 1) before shifting, which is GrayRound.
+            return vmovn_u16(vcombine_u16(vrshrn_n_u32(lo, GrayShift), vrshrn_n_u32(hi, GrayShift)));
+        }
+
+        int rowNEON(const uint8_t *src, uint8_t *dst, int width, int channels, const Weights &w) {
+            int x = 0;
+
+            if (channels == 3) {
+                for (; x + 16 <= width; x += 16) {
+                    const uint8x16x3_t px = vld3q_u8(src + x * 3);
+                    vst1q_u8(dst + x, vcombine_u8(lumaNEON(vget_low_u8(px.val[0]), vget_low_u8(px.val[1]), vget_low_u8(px.val[2]), w),
+                                                  lumaNEON(vget_high_u8(px.val[0]), vget_high_u8(px.val[1]), vget_high_u8(px.val[2]), w)));
+                }
+            } else {
+                for (; x + 16 <= width; x += 16) {
+                    const uint8x16x4_t px = vld4q_u8(src + x * 4);
+                    vst1q_u8(dst + x, vcombine_u8(lumaNEON(vget_low_u8(px.val[0]), vget_low_u8(px.val[1]), vget_low_u8(px.val[2]), w),
+                                                  lumaNEON(vget_high_u8(px.val[0]), vget_high_u8(px.val[1]), vget_high_u8(px.val[2]), w)));
+                }
+            }
+
+            return x;
+        }
+#endif
+
+        using RowFn = int (*)(const uint8_t *, uint8_t *, int, int, const Weights &);
+
+        RowFn rowFunction(Backend backend) {
+            switch (backend) {
+#if defined(LIBGRAPHICS_X86)
+                case Backend::SSE41: return rowSSE;
+                case Backend::AVX2: return rowAVX2;
+                case Backend::AVX512: return rowAVX512;
+#endif
+#if defined(LIBGRAPHICS_NEON)
+                case Backend::NEON: return rowNEON;
+#endif
+                default: return nullptr;
+            }
+        }
+    }
+
+    void grayscaleRow(Backend backend, const uint8_t *src, uint8_t *dst, int width, int channels, ChannelOrder order) {
+        const Weights w = weightsFor(order);
+        int done = 0;
+
+        if (channels == 3 || channels == 4) {
+            if (RowFn fn = rowFunction(backend))
+                done = fn(src, dst, width, channels, w);
+        }
+
+        rowScalar(src, dst, done, width, channels, w);
+    }
+
+    void grayscale(const uint8_t *src, size_t srcStride, uint8_t *dst, size_t dstStride,
+                   int width, int height, int channels, ChannelOrder order) {
+        static const Backend backend = bestBackend();
+
+        for (int y = 0; y < height; ++y) {
+            grayscaleRow(backend, src + y * srcStride, dst + y * dstStride, width, channels, order);
+        }
+    }
+}
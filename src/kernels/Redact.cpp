@@ -0,0 +1,335 @@
+#include "LibGraphics/kernels/Redact.hpp"
+#include "LibGraphics/kernels/Dispatch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using LibGraphics::Type::Rect;
+
+namespace LibGraphics::Kernels {
+
+    namespace {
+        std::vector<Rect> clipRects(const std::vector<Rect> &rects, int width, int height) {
+            const Rect frame{0, 0, width, height};
+
+            std::vector<Rect> out;
+            out.reserve(rects.size());
+            for (const auto &r: rects) {
+                const Rect c = r.intersect(frame);
+                if (c.Width > 0 && c.Height > 0) out.push_back(c);
+            }
+            return out;
+        }
+
+        Rect bounds(const Rect &a, const Rect &b) {
+            const int x0 = std::min(a.X, b.X);
+            const int y0 = std::min(a.Y, b.Y);
+            const int x1 = std::max(a.X + a.Width, b.X + b.Width);
+            const int y1 = std::max(a.Y + a.Height, b.Y + b.Height);
+            return {x0, y0, x1 - x0, y1 - y0};
+        }
+
+        bool overlaps(const Rect &a, const Rect &b, int margin) {
+            return a.X - margin < b.X + b.Width && b.X < a.X + a.Width + margin &&
+                   a.Y - margin < b.Y + b.Height && b.Y < a.Y + a.Height + margin;
+        }
+
+        // Writes `count` pixels starting at `dst`.
+        template <int Channels, int ColorChannels>
+        void fillRun(uint8_t *dst, int count, const uint8_t *color) {
+            if constexpr (ColorChannels != Channels) {
+                for (int i = 0; i < count; ++i, dst += Channels)
+                    std::memcpy(dst, color, ColorChannels);
+            } else {
+                const size_t total = static_cast<size_t>(count) * Channels;
+                if (std::all_of(color + 1, color + Channels, [&](uint8_t v) { return v == color[0]; })) {
+                    std::memset(dst, color[0], total);
+                    return;
+                }
+
+                // Seed one pixel, then keep doubling it with memcpy so the bulk runs at copy speed.
+                std::memcpy(dst, color, Channels);
+                for (size_t done = Channels; done < total;) {
+                    const size_t n = std::min(done, total - done);
+                    std::memcpy(dst + done, dst, n);
+                    done += n;
+                }
+            }
+        }
+
+        // Adds the first ColorChannels bytes of `count` pixels to sum[0..ColorChannels).
+        template <int Channels, int ColorChannels>
+        void addPixels(const uint8_t *px, int count, uint32_t *sum) {
+            uint32_t acc[ColorChannels] = {};
+            for (int i = 0; i < count; ++i, px += Channels)
+                for (int c = 0; c < ColorChannels; ++c) acc[c] += px[c];
+            for (int c = 0; c < ColorChannels; ++c) sum[c] += acc[c];
+        }
+
+        // Adds (or removes) one row of `count` pixels to the per column sums.
+        template <bool Add, int Channels, int ColorChannels>
+        void accumulateRow(uint32_t *columns, const uint8_t *row, int count) {
+            if constexpr (Channels == ColorChannels) {
+                // Same layout on both sides: one flat loop the compiler can vectorise.
+                const size_t n = static_cast<size_t>(count) * Channels;
+                for (size_t i = 0; i < n; ++i) columns[i] = Add ? columns[i] + row[i] : columns[i] - row[i];
+            } else {
+                for (int i = 0; i < count; ++i, row += Channels, columns += ColorChannels)
+                    for (int c = 0; c < ColorChannels; ++c) columns[c] = Add ? columns[c] + row[c] : columns[c] - row[c];
+            }
+        }
+
+        // Column sums of the rows around the one being blurred, for columns [x0, x1).
+        struct BlurWindow {
+            const uint32_t *columns = nullptr;
+            int x0 = 0;
+            int x1 = 0;
+            int radius = 0;
+            uint32_t rows = 0;
+        };
+
+        // Blurs pixels [from, to) of one row by sliding a window along the column sums.
+        template <int Channels, int ColorChannels>
+        void blurSpan(const BlurWindow &window, uint8_t *px, int from, int to) {
+            const uint32_t *columns = window.columns;
+            const int r = window.radius;
+
+            int wx0 = std::max(window.x0, from - r);
+            int wx1 = std::min(window.x1, from + r + 1);
+
+            uint32_t sum[ColorChannels] = {};
+            for (int x = wx0; x < wx1; ++x)
+                for (int c = 0; c < ColorChannels; ++c) sum[c] += columns[static_cast<size_t>(x - window.x0) * ColorChannels + c];
+
+            uint32_t n = 0;
+            double inv = 0;
+
+            for (int x = from; x < to; ++x, px += Channels) {
+                const uint32_t count = static_cast<uint32_t>(wx1 - wx0) * window.rows;
+                if (count != n) {
+                    n = count;
+                    inv = 1.0 / n;
+                }
+
+                // The mean is at most 255, so the product is off by far less than the 1/n
+                // gap between a quotient and the next integer; the bias keeps exact ones exact.
+                for (int c = 0; c < ColorChannels; ++c)
+                    px[c] = static_cast<uint8_t>(static_cast<double>(sum[c] + n / 2) * inv + 1e-9);
+
+                if (x + r + 1 < window.x1) {
+                    const uint32_t *in = columns + static_cast<size_t>(wx1 - window.x0) * ColorChannels;
+                    for (int c = 0; c < ColorChannels; ++c) sum[c] += in[c];
+                    ++wx1;
+                }
+                if (x - r >= window.x0) {
+                    const uint32_t *out = columns + static_cast<size_t>(wx0 - window.x0) * ColorChannels;
+                    for (int c = 0; c < ColorChannels; ++c) sum[c] -= out[c];
+                    ++wx0;
+                }
+            }
+        }
+
+        template <int Channels, int ColorChannels>
+        void fillSpansFixed(uint8_t *pixels, size_t stride, const std::vector<RowSpan> &spans, const uint8_t *color) {
+            for (const auto &s: spans)
+                fillRun<Channels, ColorChannels>(pixelAt<Channels>(pixels, stride, s.x0, s.y), s.x1 - s.x0, color);
+        }
+
+        template <int Channels, int ColorChannels>
+        void pixelateSpansFixed(uint8_t *pixels, size_t stride, int width, const std::vector<RowSpan> &spans, int block) {
+            const int cells = (width + block - 1) / block;
+            std::vector<uint32_t> sums(static_cast<size_t>(cells) * ColorChannels);
+            std::vector<uint32_t> counts(cells);
+            uint8_t color[ColorChannels] = {};
+
+            for (size_t first = 0; first < spans.size();) {
+                // Spans are sorted by row, so each band of cells is a contiguous range.
+                const int band = spans[first].y / block;
+                size_t last = first;
+                while (last < spans.size() && spans[last].y / block == band) ++last;
+
+                std::fill(sums.begin(), sums.end(), 0);
+                std::fill(counts.begin(), counts.end(), 0);
+
+                for (size_t i = first; i < last; ++i) {
+                    const RowSpan &s = spans[i];
+                    for (int x = s.x0; x < s.x1;) {
+                        const int cell = x / block;
+                        const int end = std::min(s.x1, (cell + 1) * block);
+                        addPixels<Channels, ColorChannels>(pixelAt<Channels>(pixels, stride, x, s.y), end - x,
+                                                           &sums[static_cast<size_t>(cell) * ColorChannels]);
+                        counts[cell] += end - x;
+                        x = end;
+                    }
+                }
+
+                for (size_t i = first; i < last; ++i) {
+                    const RowSpan &s = spans[i];
+                    for (int x = s.x0; x < s.x1;) {
+                        const int cell = x / block;
+                        const int end = std::min(s.x1, (cell + 1) * block);
+                        const uint32_t n = counts[cell];
+                        const uint32_t *sum = &sums[static_cast<size_t>(cell) * ColorChannels];
+                        for (int c = 0; c < ColorChannels; ++c) color[c] = static_cast<uint8_t>((sum[c] + n / 2) / n);
+
+                        fillRun<Channels, ColorChannels>(pixelAt<Channels>(pixels, stride, x, s.y), end - x, color);
+                        x = end;
+                    }
+                }
+
+                first = last;
+            }
+        }
+
+        template <int Channels, int ColorChannels>
+        void blurSpansFixed(uint8_t *pixels, size_t stride, int width, int height,
+                            const std::vector<Rect> &rects, const std::vector<RowSpan> &spans, int radius) {
+            // Boxes that stay `radius` apart never read each other's output, so each one
+            // can be blurred straight into the image.
+            const std::vector<Rect> boxes = mergeRects(rects, width, height, radius);
+            std::vector<uint32_t> columns;
+            std::vector<uint8_t> ring;
+
+            for (const Rect &box: boxes) {
+                BlurWindow window;
+                window.x0 = std::max(0, box.X - radius);
+                window.x1 = std::min(width, box.X + box.Width + radius);
+                window.radius = radius;
+
+                const int sy0 = std::max(0, box.Y - radius);
+                const int sy1 = std::min(height, box.Y + box.Height + radius);
+                const int columnCount = window.x1 - window.x0;
+                const size_t rowBytes = static_cast<size_t>(columnCount) * Channels;
+
+                // Per column sums over the rows of the current window. Rows enter the window
+                // before they are blurred, so a copy of each is kept until it leaves again.
+                const int ringRows = std::min(2 * radius + 2, sy1 - sy0);
+                columns.assign(static_cast<size_t>(columnCount) * ColorChannels, 0);
+                ring.resize(rowBytes * ringRows);
+                window.columns = columns.data();
+
+                int top = sy0;
+                int bottom = sy0;
+
+                auto it = std::lower_bound(spans.begin(), spans.end(), box.Y,
+                                           [](const RowSpan &s, int y) { return s.y < y; });
+
+                for (int y = box.Y; y < box.Y + box.Height; ++y) {
+                    for (const int end = std::min(sy1, y + radius + 1); bottom < end; ++bottom) {
+                        uint8_t *copy = &ring[static_cast<size_t>((bottom - sy0) % ringRows) * rowBytes];
+                        std::memcpy(copy, pixelAt<Channels>(pixels, stride, window.x0, bottom), rowBytes);
+                        accumulateRow<true, Channels, ColorChannels>(columns.data(), copy, columnCount);
+                    }
+                    for (const int begin = std::max(sy0, y - radius); top < begin; ++top) {
+                        const uint8_t *copy = &ring[static_cast<size_t>((top - sy0) % ringRows) * rowBytes];
+                        accumulateRow<false, Channels, ColorChannels>(columns.data(), copy, columnCount);
+                    }
+
+                    window.rows = static_cast<uint32_t>(bottom - top);
+
+                    for (; it != spans.end() && it->y == y; ++it) {
+                        if (it->x0 < box.X || it->x1 > box.X + box.Width) continue;
+                        blurSpan<Channels, ColorChannels>(window, pixelAt<Channels>(pixels, stride, it->x0, y), it->x0, it->x1);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<RowSpan> mergeSpans(const std::vector<Rect> &rects, int width, int height) {
+        std::vector<Rect> pending = clipRects(rects, width, height);
+        std::sort(pending.begin(), pending.end(), [](const Rect &a, const Rect &b) { return a.Y < b.Y; });
+
+        std::vector<RowSpan> out;
+        std::vector<Rect> active;
+        std::vector<std::pair<int, int>> row;
+
+        size_t next = 0;
+        int y = 0;
+
+        while (next < pending.size() || !active.empty()) {
+            if (active.empty()) y = std::max(y, pending[next].Y);
+
+            // Rows between two changes of the active set share the same spans.
+            bool changed = false;
+            for (; next < pending.size() && pending[next].Y <= y; ++next) {
+                active.push_back(pending[next]);
+                changed = true;
+            }
+
+            const auto done = std::remove_if(active.begin(), active.end(), [y](const Rect &r) { return r.Y + r.Height <= y; });
+            if (done != active.end()) {
+                active.erase(done, active.end());
+                changed = true;
+            }
+
+            if (active.empty()) continue;
+
+            if (changed) {
+                row.clear();
+                for (const auto &r: active) row.emplace_back(r.X, r.X + r.Width);
+                std::sort(row.begin(), row.end());
+
+                size_t kept = 0;
+                for (size_t i = 1; i < row.size(); ++i) {
+                    if (row[i].first <= row[kept].second)
+                        row[kept].second = std::max(row[kept].second, row[i].second);
+                    else
+                        row[++kept] = row[i];
+                }
+                row.resize(kept + 1);
+            }
+
+            for (const auto &[x0, x1]: row) out.push_back({y, x0, x1});
+            ++y;
+        }
+
+        return out;
+    }
+
+    std::vector<Rect> mergeRects(const std::vector<Rect> &rects, int width, int height, int margin) {
+        std::vector<Rect> boxes = clipRects(rects, width, height);
+
+        // A merged box can reach boxes it skipped earlier, so repeat until nothing moves.
+        for (bool merged = true; merged;) {
+            merged = false;
+            for (size_t i = 0; i < boxes.size(); ++i) {
+                for (size_t j = i + 1; j < boxes.size();) {
+                    if (overlaps(boxes[i], boxes[j], margin)) {
+                        boxes[i] = bounds(boxes[i], boxes[j]);
+                        boxes[j] = boxes.back();
+                        boxes.pop_back();
+                        j = i + 1;
+                        merged = true;
+                    } else {
+                        ++j;
+                    }
+                }
+            }
+        }
+
+        return boxes;
+    }
+
+    void fillSpans(uint8_t *pixels, size_t stride, int channels, int colorChannels,
+                   const std::vector<RowSpan> &spans, const uint8_t *color) {
+        dispatchLayout(channels, colorChannels, [&](auto c, auto cc) {
+            fillSpansFixed<decltype(c)::value, decltype(cc)::value>(pixels, stride, spans, color);
+        });
+    }
+
+    void pixelateSpans(uint8_t *pixels, size_t stride, int width, int channels, int colorChannels,
+                       const std::vector<RowSpan> &spans, int block) {
+        dispatchLayout(channels, colorChannels, [&](auto c, auto cc) {
+            pixelateSpansFixed<decltype(c)::value, decltype(cc)::value>(pixels, stride, width, spans, block);
+        });
+    }
+
+    void blurSpans(uint8_t *pixels, size_t stride, int width, int height, int channels, int colorChannels,
+                   const std::vector<Rect> &rects, const std::vector<RowSpan> &spans, int radius) {
+        dispatchLayout(channels, colorChannels, [&](auto c, auto cc) {
+            blurSpansFixed<decltype(c)::value, decltype(cc)::value>(pixels, stride, width, height, rects, spans, radius);
+        });
+    }
+}
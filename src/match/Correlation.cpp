@@ -0,0 +1,289 @@
+#include "LibGraphics/match/Correlation.hpp"
+#include "LibGraphics/kernels/Grayscale.hpp"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+namespace LibGraphics::Match::Detail {
+
+    int workingChannels(int templateChannels, int targetChannels, bool grayscale) {
+        if (grayscale) return 1;
+        if (templateChannels == targetChannels) return templateChannels;
+        if (templateChannels < 3 || targetChannels < 3) return 1;
+        return 3;
+    }
+
+    cv::Mat toChannels(const cv::Mat &mat, int channels) {
+        if (mat.channels() == channels) return mat;
+
+        cv::Mat out;
+        if (channels == 1 && mat.channels() == 2) {
+            cv::extractChannel(mat, out, 0);
+        } else if (channels == 1) {
+            cv::cvtColor(mat, out, mat.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+        } else if (channels == 3 && mat.channels() == 4) {
+            cv::cvtColor(mat, out, cv::COLOR_BGRA2BGR);
+        } else {
+            throw std::invalid_argument("[TemplateMatcher] Unsupported channel conversion");
+        }
+        return out;
+    }
+
+    cv::Mat workingMat(const Image &image, int channels) {
+        // Gray uses the same luma as Image::matGray(), like the grayscale option always has.
+        return channels == 1 && image.channels >= 3 ? image.matGray() : toChannels(image.mat(), channels);
+    }
+
+    TemplateStats templateStats(const cv::Mat &templ) {
+        cv::Scalar mean, sdv;
+        cv::meanStdDev(templ, mean, sdv);
+
+        TemplateStats stats;
+        stats.mean = mean;
+        stats.area = static_cast<double>(templ.rows) * templ.cols;
+        for (int k = 0; k < 4; ++k) {
+            stats.variance += sdv[k] * sdv[k];
+            stats.sum2 += mean[k] * mean[k];
+        }
+        stats.sum2 = (stats.sum2 + stats.variance) * stats.area;
+        return stats;
+    }
+
+    void normalizeScores(float *scores, size_t scoreStep, int cols, int rows,
+                         const double *sum, size_t sumStep, const double *sqsum, size_t sqsumStep,
+                         int channels, cv::Point offset, cv::Size templSize,
+                         const TemplateStats &stats, int method) {
+        // Same case analysis as OpenCV's common_matchTemplate(), except that `scores`
+        // already hold the zero-mean correlation: CCOEFF needs no mean correction and
+        // the other methods get the plain correlation back by adding it.
+        const int numType = method == cv::TM_CCORR || method == cv::TM_CCORR_NORMED ? 0
+                            : method == cv::TM_CCOEFF || method == cv::TM_CCOEFF_NORMED ? 1 : 2;
+        const bool isNormed = method == cv::TM_CCORR_NORMED || method == cv::TM_SQDIFF_NORMED ||
+                              method == cv::TM_CCOEFF_NORMED;
+
+        const double invArea = 1.0 / stats.area;
+        double templNorm = stats.variance;
+        double templSum2 = stats.sum2;
+
+        if (method == cv::TM_CCOEFF_NORMED && templNorm < DBL_EPSILON) {
+            for (int y = 0; y < rows; ++y) std::fill(scores + y * scoreStep, scores + y * scoreStep + cols, 1.0f);
+            return;
+        }
+
+        if (numType != 1) templNorm = templSum2 * invArea;
+        templNorm = std::sqrt(templNorm) / std::sqrt(invArea);
+
+        const int cn = channels;
+        const size_t dx = static_cast<size_t>(templSize.width) * cn;
+
+        for (int y = 0; y < rows; ++y) {
+            float *row = scores + y * scoreStep;
+            const double *p0 = sum + static_cast<size_t>(offset.y + y) * sumStep + static_cast<size_t>(offset.x) * cn;
+            const double *p2 = p0 + static_cast<size_t>(templSize.height) * sumStep;
+            const double *q0 = sqsum + static_cast<size_t>(offset.y + y) * sqsumStep + static_cast<size_t>(offset.x) * cn;
+            const double *q2 = q0 + static_cast<size_t>(templSize.height) * sqsumStep;
+
+            for (int x = 0; x < cols; ++x, p0 += cn, p2 += cn, q0 += cn, q2 += cn) {
+                double num = row[x];
+                double wndMean2 = 0, wndSum2 = 0, t;
+
+                for (int k = 0; k < cn; ++k) {
+                    t = p0[k] - p0[dx + k] - p2[k] + p2[dx + k];
+                    if (numType == 1)
+                        wndMean2 += t * t;
+                    else
+                        num += t * stats.mean[k];
+                }
+                wndMean2 *= invArea;
+
+                if (isNormed || numType == 2) {
+                    for (int k = 0; k < cn; ++k) wndSum2 += q0[k] - q0[dx + k] - q2[k] + q2[dx + k];
+
+                    if (numType == 2) num = std::max(wndSum2 - 2 * num + templSum2, 0.0);
+                }
+
+                if (isNormed) {
+                    const double diff2 = std::max(wndSum2 - wndMean2, 0.0);
+                    t = diff2 <= std::min(0.5, 10 * FLT_EPSILON * wndSum2) ? 0 : std::sqrt(diff2) * templNorm;
+
+                    if (std::fabs(num) < t)
+                        num /= t;
+                    else if (std::fabs(num) < t * 1.125)
+                        num = num > 0 ? 1 : -1;
+                    else
+                        num = method != cv::TM_SQDIFF_NORMED ? 0 : 1;
+                }
+
+                row[x] = static_cast<float>(num);
+            }
+        }
+    }
+
+    TemplateFormat::TemplateFormat(cv::Mat mat)
+        : mat_(std::move(mat)), stats_(templateStats(mat_)) {}
+
+    std::vector<cv::Mat> TemplateFormat::spectra(cv::Size dftSize) const {
+        std::vector<cv::Mat> planes(mat_.channels());
+        cv::split(mat_, planes.data());
+
+        std::vector<cv::Mat> out(planes.size());
+        for (size_t c = 0; c < planes.size(); ++c) {
+            cv::Mat padded = cv::Mat::zeros(dftSize, CV_32F);
+            cv::Mat inside = padded(cv::Rect(0, 0, mat_.cols, mat_.rows));
+            planes[c].convertTo(inside, CV_32F, 1.0, -stats_.mean[static_cast<int>(c)]);
+            cv::dft(padded, out[c], 0, mat_.rows);
+        }
+        return out;
+    }
+
+    std::shared_ptr<const std::vector<cv::Mat>> TemplateSpectra::at(cv::Size dftSize) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto &slot = spectra_[{dftSize.width, dftSize.height}];
+        if (!slot) slot = std::make_shared<const std::vector<cv::Mat>>(format_.spectra(dftSize));
+        return slot;
+    }
+
+    TemplateState::TemplateState(Image image) : image_(std::move(image)) {}
+
+    const TemplateFormat &TemplateState::format(int channels) const {
+        if (channels < 1 || channels > 4)
+            throw std::invalid_argument("[TemplateMatcher] Unsupported channel count");
+
+        std::call_once(once_[channels], [&] {
+            formats_[channels] = std::make_unique<TemplateFormat>(workingMat(image_, channels));
+        });
+
+        return *formats_[channels];
+    }
+
+    TargetState::TargetState(cv::Mat mat, IntegralImage tables, bool cacheSpectra, cv::Point origin)
+        : mat_(std::move(mat)), tables_(std::move(tables)), cacheSpectra_(cacheSpectra), origin_(origin) {}
+
+    static IntegralImage integralOf(const cv::Mat &mat) {
+        cv::Mat sum, sqsum;
+        cv::integral(mat, sum, sqsum, CV_64F, CV_64F);
+        return IntegralImage(sum, sqsum);
+    }
+
+    // workingMat() of the pixels inside `bounds`, converting no more than those.
+    static cv::Mat workingMat(const Image &image, int channels, const cv::Rect &bounds) {
+        if (bounds == cv::Rect(0, 0, image.width, image.height))
+            return workingMat(image, channels);
+
+        const cv::Mat roi = image.mat()(bounds);
+        if (channels != 1 || image.channels < 3)
+            return toChannels(roi, channels);
+
+        // The kernel behind matGray(), so both paths see the same gray values.
+        cv::Mat gray(bounds.height, bounds.width, CV_8UC1);
+        Kernels::grayscale(roi.data, roi.step, gray.data, gray.step, bounds.width, bounds.height, image.channels,
+                           Kernels::ChannelOrder::BGR);
+        return gray;
+    }
+
+    std::shared_ptr<TargetState> TargetState::fromImage(const Image &image, int channels, const cv::Rect &bounds,
+                                                        bool cacheSpectra) {
+        if (!image.isValid())
+            throw std::runtime_error("[TemplateMatcher] Invalid target image");
+
+        // The tables belong to the state and go with it; the Image keeps only its pixel-sized caches.
+        cv::Mat mat = workingMat(image, channels, bounds);
+        IntegralImage tables = integralOf(mat);
+        return std::make_shared<TargetState>(std::move(mat), std::move(tables), cacheSpectra, bounds.tl());
+    }
+
+    std::shared_ptr<TargetState> TargetState::fromView(const ImageView &view, int channels, const cv::Rect &bounds,
+                                                       bool cacheSpectra) {
+        if (!view)
+            throw std::runtime_error("[TemplateMatcher] Invalid image view");
+
+        cv::Mat mat = toChannels(view.mat()(bounds), channels);
+        IntegralImage tables = integralOf(mat);
+        return std::make_shared<TargetState>(std::move(mat), std::move(tables), cacheSpectra, bounds.tl());
+    }
+
+    std::shared_ptr<const std::vector<cv::Mat>> TargetState::spectra(const cv::Rect &region, cv::Size dftSize, bool share) const {
+        const std::array<int, 4> key{region.x, region.y, region.width, region.height};
+        const bool cached = cacheSpectra_ && share;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (cached) {
+            const auto it = spectra_.find(key);
+            if (it != spectra_.end()) return it->second;
+        } else {
+            lock.unlock();
+        }
+
+        const cv::Mat pixels = roi(region);
+        std::vector<cv::Mat> planes(pixels.channels());
+        cv::split(pixels, planes.data());
+
+        const double area = static_cast<double>(region.width) * region.height;
+        const Rect window{region.x - origin_.x, region.y - origin_.y, region.width, region.height};
+
+        auto out = std::make_shared<std::vector<cv::Mat>>(planes.size());
+        for (size_t c = 0; c < planes.size(); ++c) {
+            // Removing the region mean does not change the correlation with a zero-mean
+            // template, it only shrinks the values the float DFT has to carry.
+            const double mean = tables_.sum(window, static_cast<int>(c)) / area;
+
+            cv::Mat padded = cv::Mat::zeros(dftSize, CV_32F);
+            cv::Mat inside = padded(cv::Rect(0, 0, region.width, region.height));
+            planes[c].convertTo(inside, CV_32F, 1.0, -mean);
+            cv::dft(padded, (*out)[c], 0, region.height);
+        }
+
+        if (cached) spectra_[key] = out;
+        return out;
+    }
+
+    size_t TargetState::cachedRegions() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return spectra_.size();
+    }
+
+    cv::Mat scoreMap(const TemplateSpectra &templ, const TargetState &target, const cv::Rect &region, int method,
+                     bool shareRegion) {
+        const cv::Mat &t = templ.format().mat();
+        if (region.width < t.cols || region.height < t.rows)
+            throw std::runtime_error("Target image is smaller than query image.");
+        if (method < cv::TM_SQDIFF || method > cv::TM_CCOEFF_NORMED)
+            throw std::invalid_argument("[TemplateMatcher] Unknown match method");
+
+        const int cols = region.width - t.cols + 1;
+        const int rows = region.height - t.rows + 1;
+        const cv::Size dftSize(cv::getOptimalDFTSize(region.width), cv::getOptimalDFTSize(region.height));
+
+        const auto targetSpectra = target.spectra(region, dftSize, shareRegion);
+        const auto templSpectra = templ.at(dftSize);
+
+        // The spectra are linear, so the channels are summed before the single inverse transform.
+        cv::Mat product, channel;
+        for (size_t c = 0; c < templSpectra->size(); ++c) {
+            cv::mulSpectrums((*targetSpectra)[c], (*templSpectra)[c], c == 0 ? product : channel, 0, true);
+            if (c != 0) product += channel;
+        }
+
+        cv::Mat correlation;
+        cv::dft(product, correlation, cv::DFT_INVERSE | cv::DFT_REAL_OUTPUT | cv::DFT_SCALE, rows);
+        cv::Mat scores = correlation(cv::Rect(0, 0, cols, rows));
+
+        const IntegralImage &tables = target.tables();
+        const cv::Mat &sum = tables.sumTable();
+        const cv::Mat &sqsum = tables.squaredSumTable();
+        const TemplateStats &stats = templ.format().stats();
+
+        cv::parallel_for_(cv::Range(0, rows), [&](const cv::Range &range) {
+            normalizeScores(scores.ptr<float>(range.start), scores.step / sizeof(float), cols, range.end - range.start,
+                            sum.ptr<double>(), sum.step / sizeof(double), sqsum.ptr<double>(), sqsum.step / sizeof(double),
+                            t.channels(), region.tl() - target.origin() + cv::Point(0, range.start), t.size(), stats, method);
+        });
+
+        return scores;
+    }
+}
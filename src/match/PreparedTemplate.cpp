@@ -0,0 +1,38 @@
+#include "LibGraphics/match/PreparedTemplate.hpp"
+#include "LibGraphics/match/Correlation.hpp"
+
+#include <stdexcept>
+
+namespace LibGraphics::Match {
+
+    PreparedTemplate::PreparedTemplate(const Image &image, const MatchOptions &options) : options_(options) {
+        if (!image.isValid())
+            throw std::invalid_argument("[PreparedTemplate] Invalid template image");
+
+        auto state = std::make_shared<Detail::TemplateState>(image);
+
+        // Build the format a target with the same channel count needs right away;
+        // the others follow on first use.
+        (void) state->format(Detail::workingChannels(image.channels, image.channels, options.grayscale));
+        state_ = std::move(state);
+    }
+
+    int PreparedTemplate::width() const {
+        return state_ ? state_->image().width : 0;
+    }
+
+    int PreparedTemplate::height() const {
+        return state_ ? state_->image().height : 0;
+    }
+
+    const Image &PreparedTemplate::image() const {
+        static const Image empty;
+        return state_ ? state_->image() : empty;
+    }
+
+    PreparedTemplate PreparedTemplate::withOptions(const MatchOptions &options) const {
+        PreparedTemplate copy = *this;
+        copy.options_ = options;
+        return copy;
+    }
+}
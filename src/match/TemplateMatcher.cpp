@@ -1,6 +1,7 @@
 #include "LibGraphics/match/TemplateMatcher.hpp"
 #include "LibGraphics/exceptions/LowConfidenceException.hpp"
 #include "LibGraphics/match/MatchOptions.hpp"
+#include "LibGraphics/match/Correlation.hpp"
 
 #include <LibGraphics/utils/Converter.hpp>
 #include "LibGraphics/Image.hpp"
@@ -8,11 +9,21 @@
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
 #include <algorithm>
+#include <array>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
 
 using LibGraphics::Utils::Converter;
 using LibGraphics::Match::TemplateMatcher;
 using LibGraphics::Match::MatchResult;
 using LibGraphics::Match::MatchOptions;
+using LibGraphics::Match::PreparedTemplate;
+using LibGraphics::Match::Detail::TargetState;
+using LibGraphics::Match::Detail::TemplateState;
+using LibGraphics::Match::Detail::TemplateSpectra;
 using LibGraphics::Exceptions::LowConfidenceException;
 
 static double normalizeScore(double score, int matchMethod) {
@@ -56,42 +67,47 @@ static void ensureCompatibleFormats(cv::Mat &query, cv::Mat &target) {
     }
 }
 
-// Main implementation with options
-MatchResult TemplateMatcher::matchTemplateSingle(
-    const Image &match_template,
-    const Image &match_target,
-    const MatchOptions &options
-) {
+static cv::Mat viewMat(const LibGraphics::ImageView &view, bool grayscale) {
+    if (!view)
+        throw std::runtime_error("[TemplateMatcher] Invalid image view");
 
-    cv::Mat targetMat   = options.grayscale ? match_target.matGray()   : match_target.mat();
-    cv::Mat templateMat = options.grayscale ? match_template.matGray()    : match_template.mat();
+    cv::Mat mat = view.mat();
+    if (!grayscale || view.channels == 1)
+        return mat;
 
+    // Only the viewed region gets converted, not the image behind it.
+    cv::Mat gray;
+    cv::cvtColor(mat, gray, view.channels == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+    return gray;
+}
 
-    // Ensure compatible formats
-    ensureCompatibleFormats(templateMat, targetMat);
+static bool lowerIsBetter(int matchMethod) {
+    return matchMethod == cv::TM_SQDIFF || matchMethod == cv::TM_SQDIFF_NORMED;
+}
 
-    cv::Mat result;
+// A score and where it is.
+using Peak = std::pair<double, cv::Point>;
 
-    if (targetMat.cols < templateMat.cols || targetMat.rows < templateMat.rows) {
-        throw std::runtime_error("Target image is smaller than query image.");
-    }
+static bool isBetter(const Peak &candidate, const Peak &best, int matchMethod) {
+    return lowerIsBetter(matchMethod) ? candidate.first < best.first : candidate.first > best.first;
+}
 
-    int matchMethod = options.getMethod();
-    cv::matchTemplate(targetMat, templateMat, result, matchMethod);
+// Best score of a cv::matchTemplate result map and where it is.
+static Peak peak(const cv::Mat &result, int matchMethod) {
     double minVal, maxVal;
     cv::Point minLoc, maxLoc;
     cv::minMaxLoc(result, &minVal, &maxVal, &minLoc, &maxLoc);
 
-    double score = (matchMethod == cv::TM_SQDIFF || matchMethod == cv::TM_SQDIFF_NORMED)
-                       ? minVal
-                       : maxVal;
-    cv::Point matchLoc = (matchMethod == cv::TM_SQDIFF || matchMethod == cv::TM_SQDIFF_NORMED)
-                             ? minLoc
-                             : maxLoc;
+    if (lowerIsBetter(matchMethod)) return {minVal, minLoc};
+    return {maxVal, maxLoc};
+}
 
+// The match at `matchLoc`, or LowConfidenceException when its score misses options.minConfidence.
+static MatchResult acceptMatch(const Peak &match, cv::Size templSize, const MatchOptions &options) {
+    const auto [score, matchLoc] = match;
     if (options.minConfidence > 0.0) {
         static constexpr double EPS = 1e-6;
-        const double normalizedScore = normalizeScore(score, matchMethod);
+        const double normalizedScore = normalizeScore(score, options.getMethod());
         const bool gotMatch = (normalizedScore + EPS >= options.minConfidence);
 
         if (!gotMatch) {
@@ -99,52 +115,37 @@ MatchResult TemplateMatcher::matchTemplateSingle(
         }
     }
 
-    return MatchResult((int) matchLoc.x, (int) matchLoc.y, templateMat.cols, templateMat.rows, score);
+    return MatchResult(matchLoc.x, matchLoc.y, templSize.width, templSize.height, score);
 }
 
-// Find all occurrences above threshold
-std::vector<MatchResult> TemplateMatcher::matchTemplateMultiple(
-    const Image &match_template,
-    const Image &match_target,
-    const MatchOptions &options
-) {
-    std::vector<MatchResult> results;
-    cv::Mat templateMat = match_template.mat();
-    cv::Mat targetMat = match_target.mat();
-
-    // Ensure compatible formats
-    ensureCompatibleFormats(templateMat, targetMat);
-
-    cv::Mat result;
+// Best score of a cv::matchTemplate result map; `offset` moves it into target coordinates.
+static MatchResult bestMatch(const cv::Mat &result, cv::Size templSize, const MatchOptions &options,
+                             cv::Point offset = cv::Point()) {
+    const auto [score, matchLoc] = peak(result, options.getMethod());
+    return acceptMatch({score, matchLoc + offset}, templSize, options);
+}
 
-    if (targetMat.cols < templateMat.cols || targetMat.rows < templateMat.rows) {
-        throw std::runtime_error("Target image is smaller than query image.");
-    }
+// Every match above options.minConfidence, strongest first, or just the best one without a threshold.
+static std::vector<MatchResult> allMatches(const cv::Mat &result, cv::Size templSize, const MatchOptions &options,
+                                           cv::Point offset = cv::Point()) {
+    std::vector<MatchResult> results;
 
     int matchMethod = options.getMethod();
-    cv::matchTemplate(targetMat, templateMat, result, matchMethod);
 
     // For SQDIFF methods, good matches have low values
-    bool invertThreshold = (matchMethod == cv::TM_SQDIFF || matchMethod == cv::TM_SQDIFF_NORMED);
+    bool invertThreshold = lowerIsBetter(matchMethod);
 
     // Use minConfidence as threshold (default 0.0 means find all matches)
     double threshold = options.minConfidence;
 
     // If no confidence threshold set, just return the best match
     if (threshold <= 0.0) {
-        double minVal, maxVal;
-        cv::Point minLoc, maxLoc;
-        cv::minMaxLoc(result, &minVal, &maxVal, &minLoc, &maxLoc);
-
-        double score = invertThreshold ? minVal : maxVal;
-        cv::Point matchLoc = invertThreshold ? minLoc : maxLoc;
-
-        results.push_back(MatchResult(matchLoc.x, matchLoc.y, templateMat.cols, templateMat.rows, score));
+        results.push_back(bestMatch(result, templSize, options, offset));
         return results;
     }
 
     // Find all matches above threshold with non-maximum suppression
-    int windowSize = std::max(templateMat.cols, templateMat.rows) / 4; // Suppression window
+    int windowSize = std::max(templSize.width, templSize.height) / 4; // Suppression window
 
     // Create a copy for marking processed areas
     cv::Mat resultCopy = result.clone();
@@ -167,7 +168,7 @@ std::vector<MatchResult> TemplateMatcher::matchTemplateMultiple(
         }
 
         // Add this match
-        results.push_back(MatchResult(matchLoc.x, matchLoc.y, templateMat.cols, templateMat.rows, score));
+        results.push_back(MatchResult(matchLoc.x + offset.x, matchLoc.y + offset.y, templSize.width, templSize.height, score));
 
         // Suppress nearby matches to avoid duplicates
         int x1 = std::max(0, matchLoc.x - windowSize);
@@ -185,3 +186,564 @@ std::vector<MatchResult> TemplateMatcher::matchTemplateMultiple(
 
     return results;
 }
+
+static void requireFits(cv::Size templSize, cv::Size targetSize) {
+    if (targetSize.width < templSize.width || targetSize.height < templSize.height) {
+        throw std::runtime_error("Target image is smaller than query image.");
+    }
+}
+
+static cv::Mat scoreMap(cv::Mat &templateMat, cv::Mat &targetMat, const MatchOptions &options) {
+    // Ensure compatible formats
+    ensureCompatibleFormats(templateMat, targetMat);
+
+    cv::Mat result;
+    requireFits(templateMat.size(), targetMat.size());
+
+    cv::matchTemplate(targetMat, templateMat, result, options.getMethod());
+    return result;
+}
+
+// Smallest side a template keeps at the coarse level of a pyramid search.
+static constexpr int MIN_PYRAMID_TEMPLATE = 8;
+
+// Level the coarse pass runs at: options.pyramidLevels, or fewer for small templates.
+static int pyramidDepth(cv::Size templSize, const MatchOptions &options) {
+    int level = 0;
+    while (level < options.pyramidLevels && std::min(templSize.width, templSize.height) >= 2 * MIN_PYRAMID_TEMPLATE) {
+        templSize = cv::Size((templSize.width + 1) / 2, (templSize.height + 1) / 2);
+        ++level;
+    }
+    return level;
+}
+
+// Halves `mat` `level` times with the rounding and filter of Image::pyramidLevel().
+static cv::Mat pyramidDown(const cv::Mat &mat, int level) {
+    cv::Mat out = mat;
+    for (int i = 0; i < level; ++i) {
+        cv::Mat half;
+        cv::resize(out, half, cv::Size((out.cols + 1) / 2, (out.rows + 1) / 2), 0, 0, cv::INTER_AREA);
+        out = half;
+    }
+    return out;
+}
+
+// Up to `count` peaks of a coarse result map, strongest first, half a template apart.
+static std::vector<cv::Point> coarsePeaks(cv::Mat result, cv::Size templSize, int matchMethod, int count) {
+    const int radius = std::max(1, std::min(templSize.width, templSize.height) / 2);
+    const cv::Rect frame(0, 0, result.cols, result.rows);
+
+    const float suppressed = lowerIsBetter(matchMethod) ? std::numeric_limits<float>::max()
+                                                         : std::numeric_limits<float>::lowest();
+
+    std::vector<cv::Point> peaks;
+    while (static_cast<int>(peaks.size()) < count) {
+        const auto [score, loc] = peak(result, matchMethod);
+        if (score == suppressed) break; // Everything left is suppressed
+
+        peaks.push_back(loc);
+        const cv::Rect suppressRect = cv::Rect(loc.x - radius, loc.y - radius, 2 * radius + 1, 2 * radius + 1) & frame;
+        result(suppressRect).setTo(suppressed);
+    }
+    return peaks;
+}
+
+using FineScores = std::function<cv::Mat(const cv::Rect &)>;
+
+// Coarse-to-fine search: match the downscaled pair, then let `fineScores` rescore a small
+// full-resolution window around each coarse candidate. The peak carries a full-resolution score.
+static Peak pyramidPeak(const cv::Mat &coarseTemplate, const cv::Mat &coarseTarget, cv::Size templSize,
+                        cv::Size targetSize, int level, const MatchOptions &options, const FineScores &fineScores) {
+    const int matchMethod = options.getMethod();
+
+    cv::Mat coarse;
+    cv::matchTemplate(coarseTarget, coarseTemplate, coarse, matchMethod);
+
+    const double scaleX = static_cast<double>(targetSize.width) / coarseTarget.cols;
+    const double scaleY = static_cast<double>(targetSize.height) / coarseTarget.rows;
+    // Two coarse pixels either way covers the rounding of both the halving and the peak.
+    const int margin = 2 << level;
+    const cv::Rect frame(0, 0, targetSize.width, targetSize.height);
+
+    bool found = false;
+    Peak best;
+
+    for (const cv::Point &candidate : coarsePeaks(coarse, coarseTemplate.size(), matchMethod, std::max(1, options.pyramidCandidates))) {
+        const int x = std::min(cvRound(candidate.x * scaleX), targetSize.width - templSize.width);
+        const int y = std::min(cvRound(candidate.y * scaleY), targetSize.height - templSize.height);
+        const cv::Rect window = cv::Rect(x - margin, y - margin, templSize.width + 2 * margin, templSize.height + 2 * margin) & frame;
+
+        const auto [score, loc] = peak(fineScores(window), matchMethod);
+        const Peak refined{score, loc + window.tl()};
+        if (!found || isBetter(refined, best, matchMethod)) {
+            found = true;
+            best = refined;
+        }
+    }
+
+    return best;
+}
+
+// Best peak of `templateMat` in `targetMat`, coarse-to-fine when `level` > 0. Missing coarse
+// levels are halved from the full-resolution pixels.
+static Peak searchSingle(cv::Mat templateMat, cv::Mat targetMat, const MatchOptions &options, int level = 0,
+                         cv::Mat coarseTemplate = cv::Mat(), cv::Mat coarseTarget = cv::Mat()) {
+    const int matchMethod = options.getMethod();
+    if (level == 0)
+        return peak(scoreMap(templateMat, targetMat, options), matchMethod);
+
+    if (coarseTemplate.empty()) coarseTemplate = pyramidDown(templateMat, level);
+    if (coarseTarget.empty()) coarseTarget = pyramidDown(targetMat, level);
+
+    ensureCompatibleFormats(templateMat, targetMat);
+    ensureCompatibleFormats(coarseTemplate, coarseTarget);
+    requireFits(templateMat.size(), targetMat.size());
+
+    return pyramidPeak(coarseTemplate, coarseTarget, templateMat.size(), targetMat.size(), level, options,
+                       [&](const cv::Rect &window) {
+                           cv::Mat result;
+                           cv::matchTemplate(targetMat(window), templateMat, result, matchMethod);
+                           return result;
+                       });
+}
+
+// options.searchRegions clipped to the target, or the whole target without any.
+// Regions the template does not fit in are skipped.
+static std::vector<cv::Rect> searchRegions(cv::Size templSize, cv::Size targetSize, const MatchOptions &options) {
+    const cv::Rect frame(0, 0, targetSize.width, targetSize.height);
+    if (options.searchRegions.empty()) {
+        requireFits(templSize, targetSize);
+        return {frame};
+    }
+
+    std::vector<cv::Rect> regions;
+    for (const auto &region : options.searchRegions) {
+        const cv::Rect clipped = cv::Rect(region.X, region.Y, region.Width, region.Height) & frame;
+        if (clipped.width >= templSize.width && clipped.height >= templSize.height)
+            regions.push_back(clipped);
+    }
+
+    if (regions.empty())
+        throw std::runtime_error("[TemplateMatcher] No search region is large enough for the template");
+    return regions;
+}
+
+// Splits `region` into tiles of about `tileSize` pixels that overlap by the template size less
+// one, so every template position lies in exactly one tile. 0 keeps the region whole.
+static std::vector<cv::Rect> tilesOf(const cv::Rect &region, cv::Size templSize, int tileSize) {
+    // At least twice the template, or the overlap would be most of every tile
+    const int tileW = std::max(tileSize, 2 * templSize.width);
+    const int tileH = std::max(tileSize, 2 * templSize.height);
+    if (tileSize <= 0 || (region.width <= tileW && region.height <= tileH))
+        return {region};
+
+    const int right = region.x + region.width;
+    const int bottom = region.y + region.height;
+
+    std::vector<cv::Rect> tiles;
+    for (int y = region.y;; y += tileH - templSize.height + 1) {
+        const int h = std::min(tileH, bottom - y);
+        for (int x = region.x;; x += tileW - templSize.width + 1) {
+            const int w = std::min(tileW, right - x);
+            tiles.emplace_back(x, y, w, h);
+            if (x + w >= right) break;
+        }
+        if (y + h >= bottom) break;
+    }
+    return tiles;
+}
+
+// A piece of a search region to score; `whole` when the region was not split.
+struct SearchTile {
+    cv::Rect rect;
+    bool whole;
+};
+
+// The search regions split into tiles when options.tileSize is set and `tiled` allows it.
+static std::vector<SearchTile> searchTiles(cv::Size templSize, cv::Size targetSize, const MatchOptions &options, bool tiled) {
+    std::vector<SearchTile> tiles;
+    for (const cv::Rect &region : searchRegions(templSize, targetSize, options)) {
+        const auto inRegion = tilesOf(region, templSize, tiled ? options.tileSize : 0);
+        for (const cv::Rect &tile : inRegion) tiles.push_back({tile, inRegion.size() == 1});
+    }
+    return tiles;
+}
+
+// Runs `body(i)` for every tile, spread over the cores when there is more than one.
+template <typename Body>
+static void forEachTile(size_t count, Body body) {
+    if (count == 1) {
+        body(0);
+        return;
+    }
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(count)), [&](const cv::Range &range) {
+        for (int i = range.start; i < range.end; ++i) body(static_cast<size_t>(i));
+    });
+}
+
+// Best match over the search regions in target coordinates; `search(rect, whole)` finds the peak
+// inside one region or tile. `tiled` lets options.tileSize split the regions.
+template <typename Search>
+static MatchResult bestInRegions(cv::Size templSize, cv::Size targetSize, const MatchOptions &options, Search search,
+                                 bool tiled = true) {
+    const int matchMethod = options.getMethod();
+    const std::vector<SearchTile> tiles = searchTiles(templSize, targetSize, options, tiled);
+
+    std::vector<Peak> peaks(tiles.size());
+    forEachTile(tiles.size(), [&](size_t i) {
+        const auto [score, loc] = search(tiles[i].rect, tiles[i].whole);
+        peaks[i] = {score, loc + tiles[i].rect.tl()};
+    });
+
+    Peak best = peaks.front();
+    for (const Peak &candidate : peaks) {
+        if (isBetter(candidate, best, matchMethod)) best = candidate;
+    }
+
+    return acceptMatch(best, templSize, options);
+}
+
+// allMatches() over the search regions in target coordinates, strongest first; `scores(rect, whole)`
+// gives the result map of one region or tile. Matches that overlapping regions or neighbouring tiles
+// both found are reported once.
+template <typename Scores>
+static std::vector<MatchResult> matchesInRegions(cv::Size templSize, cv::Size targetSize, const MatchOptions &options,
+                                                 Scores scores) {
+    const int matchMethod = options.getMethod();
+    const std::vector<SearchTile> tiles = searchTiles(templSize, targetSize, options, true);
+
+    if (tiles.size() == 1)
+        return allMatches(scores(tiles.front().rect, tiles.front().whole), templSize, options, tiles.front().rect.tl());
+
+    // Without a threshold allMatches() reports the best match only.
+    if (options.minConfidence <= 0.0)
+        return {bestInRegions(templSize, targetSize, options, [&](const cv::Rect &tile, bool whole) {
+            return peak(scores(tile, whole), matchMethod);
+        })};
+
+    // One result map per tile at a time, so memory follows the tile size rather than the target.
+    std::vector<std::vector<MatchResult>> perTile(tiles.size());
+    forEachTile(tiles.size(), [&](size_t i) {
+        perTile[i] = allMatches(scores(tiles[i].rect, tiles[i].whole), templSize, options, tiles[i].rect.tl());
+    });
+
+    std::vector<MatchResult> found;
+    for (const auto &inTile : perTile) {
+        found.insert(found.end(), inTile.begin(), inTile.end());
+    }
+
+    std::stable_sort(found.begin(), found.end(), [&](const MatchResult &a, const MatchResult &b) {
+        return normalizeScore(a.Score, matchMethod) > normalizeScore(b.Score, matchMethod);
+    });
+
+    // Same suppression window as allMatches()
+    const int windowSize = std::max(templSize.width, templSize.height) / 4;
+
+    std::vector<MatchResult> results;
+    for (const MatchResult &match : found) {
+        const bool duplicate = std::any_of(results.begin(), results.end(), [&](const MatchResult &kept) {
+            return std::abs(kept.X - match.X) <= windowSize && std::abs(kept.Y - match.Y) <= windowSize;
+        });
+        if (!duplicate) results.push_back(match);
+    }
+
+    return results;
+}
+
+static std::shared_ptr<TargetState> targetState(const LibGraphics::Image &target, int channels, const cv::Rect &bounds,
+                                                bool cacheSpectra) {
+    return TargetState::fromImage(target, channels, bounds, cacheSpectra);
+}
+
+static std::shared_ptr<TargetState> targetState(const LibGraphics::ImageView &target, int channels, const cv::Rect &bounds,
+                                                bool cacheSpectra) {
+    return TargetState::fromView(target, channels, bounds, cacheSpectra);
+}
+
+// Coarse level of a whole target in the working format: Image targets use their cached pyramid.
+static cv::Mat coarseTarget(const LibGraphics::Image &target, const TargetState &, int level, int channels) {
+    return LibGraphics::Match::Detail::workingMat(target.pyramidLevel(level), channels);
+}
+
+static cv::Mat coarseTarget(const LibGraphics::ImageView &, const TargetState &state, int level, int) {
+    return pyramidDown(state.mat(), level);
+}
+
+// Smallest rectangle holding every search region, the whole target without any.
+static cv::Rect searchBounds(cv::Size templSize, cv::Size targetSize, const MatchOptions &options) {
+    const std::vector<cv::Rect> regions = searchRegions(templSize, targetSize, options);
+
+    cv::Rect bounds = regions.front();
+    for (const cv::Rect &region : regions) bounds |= region;
+    return bounds;
+}
+
+// Target side of prepared matches, built per working channel count and search bounds on first use,
+// so search regions only ever convert and tabulate their own pixels. matchMany() shares one between
+// every template, with the spectra cached for the templates that follow.
+template <typename Target>
+class PreparedTarget {
+public:
+    PreparedTarget(const Target &target, bool cacheSpectra) : target_(target), cacheSpectra_(cacheSpectra) {}
+
+    [[nodiscard]] int channels() const { return target_.channels; }
+    [[nodiscard]] cv::Size size() const { return {target_.width, target_.height}; }
+
+    const TargetState &state(int channels, const cv::Rect &bounds) const {
+        std::shared_ptr<Slot> slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &entry = states_[{channels, {bounds.x, bounds.y, bounds.width, bounds.height}}];
+            if (!entry) entry = std::make_shared<Slot>();
+            slot = entry;
+        }
+
+        // Built outside the lock, so templates searching other bounds are not held up.
+        std::call_once(slot->once, [&] { slot->state = targetState(target_, channels, bounds, cacheSpectra_); });
+        return *slot->state;
+    }
+
+    cv::Mat coarse(int channels, int level) const {
+        const TargetState &working = state(channels, cv::Rect(cv::Point(), size()));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv::Mat &slot = coarse_[{channels, level}];
+        if (slot.empty()) slot = coarseTarget(target_, working, level, channels);
+        return slot;
+    }
+
+private:
+    struct Slot {
+        std::once_flag once;
+        std::shared_ptr<TargetState> state;
+    };
+
+    const Target &target_;
+    bool cacheSpectra_;
+
+    mutable std::mutex mutex_;
+    mutable std::map<std::pair<int, std::array<int, 4>>, std::shared_ptr<Slot>> states_;
+    mutable std::map<std::pair<int, int>, cv::Mat> coarse_;
+};
+
+static const TemplateState &requireState(const std::shared_ptr<const TemplateState> &state) {
+    if (!state)
+        throw std::runtime_error("[TemplateMatcher] Invalid prepared template");
+    return *state;
+}
+
+template <typename Target>
+static MatchResult preparedMatchSingle(const TemplateState &state, const PreparedTarget<Target> &target,
+                                       const MatchOptions &options) {
+    const int channels = LibGraphics::Match::Detail::workingChannels(state.image().channels, target.channels(), options.grayscale);
+    const auto &format = state.format(channels);
+    const TemplateSpectra spectra(format);
+
+    const cv::Size templSize = format.mat().size();
+    const cv::Size targetSize = target.size();
+    const TargetState &prepared = target.state(channels, searchBounds(templSize, targetSize, options));
+    const int matchMethod = options.getMethod();
+    const int level = pyramidDepth(templSize, options);
+
+    cv::Mat coarseTemplate, coarseFrame;
+    if (level > 0) {
+        coarseTemplate = LibGraphics::Match::Detail::workingMat(state.image().pyramidLevel(level), channels);
+        if (options.searchRegions.empty() && targetSize.width >= templSize.width && targetSize.height >= templSize.height)
+            coarseFrame = target.coarse(channels, level);
+    }
+
+    return bestInRegions(templSize, targetSize, options, [&](const cv::Rect &region, bool whole) {
+        // Whole regions are what the other templates search too; tiles are dropped after use,
+        // so the target keeps no more than its untiled regions.
+        if (level == 0)
+            return peak(LibGraphics::Match::Detail::scoreMap(spectra, prepared, region, matchMethod, whole), matchMethod);
+
+        const cv::Mat coarse = coarseFrame.empty() ? pyramidDown(prepared.roi(region), level) : coarseFrame;
+        return pyramidPeak(coarseTemplate, coarse, templSize, region.size(), level, options, [&](const cv::Rect &window) {
+            // Refine windows depend on this template's candidates, nobody else reuses them.
+            return LibGraphics::Match::Detail::scoreMap(spectra, prepared, window + region.tl(), matchMethod, false);
+        });
+    }, level == 0);
+}
+
+template <typename Target>
+static std::vector<MatchResult> preparedMatchMultiple(const TemplateState &state, const PreparedTarget<Target> &target,
+                                                      const MatchOptions &options) {
+    // Colour regardless of options.grayscale, like the Image and ImageView overloads
+    const int channels = LibGraphics::Match::Detail::workingChannels(state.image().channels, target.channels(), false);
+    const auto &format = state.format(channels);
+    const TemplateSpectra spectra(format);
+
+    const cv::Size templSize = format.mat().size();
+    const TargetState &prepared = target.state(channels, searchBounds(templSize, target.size(), options));
+
+    return matchesInRegions(templSize, target.size(), options, [&](const cv::Rect &region, bool whole) {
+        return LibGraphics::Match::Detail::scoreMap(spectra, prepared, region, options.getMethod(), whole);
+    });
+}
+
+// Best match of every template against one shared target, templates spread over the cores.
+// `templateOf(i)` gives the state of template i, `optionsOf(i)` its options.
+template <typename Target, typename TemplateOf, typename OptionsOf>
+static std::vector<std::optional<MatchResult>> matchEach(size_t count, const Target &target, TemplateOf templateOf,
+                                                         OptionsOf optionsOf) {
+    const PreparedTarget<Target> prepared(target, true);
+
+    std::vector<std::optional<MatchResult>> results(count);
+    std::vector<std::exception_ptr> errors(count);
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(count)), [&](const cv::Range &range) {
+        for (int i = range.start; i < range.end; ++i) {
+            try {
+                results[i] = preparedMatchSingle(requireState(templateOf(i)), prepared, optionsOf(i));
+            } catch (const LowConfidenceException &) {
+                // Below its threshold: no result for this template
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    });
+
+    for (const auto &error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    return results;
+}
+
+// Main implementation with options
+MatchResult TemplateMatcher::matchTemplateSingle(
+    const Image &match_template,
+    const Image &match_target,
+    const MatchOptions &options
+) {
+    cv::Mat targetMat   = options.grayscale ? match_target.matGray()   : match_target.mat();
+    cv::Mat templateMat = options.grayscale ? match_template.matGray() : match_template.mat();
+
+    const int level = pyramidDepth(templateMat.size(), options);
+    cv::Mat coarseTemplate, coarseTarget;
+    if (level > 0 && match_target.isValid()) {
+        // Both images keep their coarse levels cached for the next match; search regions halve their own pixels.
+        const Image templateLevel = match_template.pyramidLevel(level);
+        coarseTemplate = options.grayscale ? templateLevel.matGray() : templateLevel.mat();
+        if (options.searchRegions.empty()) {
+            const Image targetLevel = match_target.pyramidLevel(level);
+            coarseTarget = options.grayscale ? targetLevel.matGray() : targetLevel.mat();
+        }
+    }
+
+    return bestInRegions(templateMat.size(), targetMat.size(), options, [&](const cv::Rect &region, bool) {
+        return searchSingle(templateMat, targetMat(region), options, level, coarseTemplate, coarseTarget);
+    }, level == 0);
+}
+
+// Find all occurrences above threshold
+std::vector<MatchResult> TemplateMatcher::matchTemplateMultiple(
+    const Image &match_template,
+    const Image &match_target,
+    const MatchOptions &options
+) {
+    const cv::Mat templateMat = match_template.mat();
+    const cv::Mat targetMat = match_target.mat();
+
+    return matchesInRegions(templateMat.size(), targetMat.size(), options, [&](const cv::Rect &region, bool) {
+        cv::Mat query = templateMat;
+        cv::Mat target = targetMat(region);
+        return scoreMap(query, target, options);
+    });
+}
+
+MatchResult TemplateMatcher::matchTemplateSingle(
+    const ImageView &match_template,
+    const ImageView &match_target,
+    const MatchOptions &options
+) {
+    const cv::Mat templateMat = viewMat(match_template, options.grayscale);
+    const cv::Mat targetMat = viewMat(match_target, options.grayscale);
+    const int level = pyramidDepth(templateMat.size(), options);
+
+    return bestInRegions(templateMat.size(), targetMat.size(), options, [&](const cv::Rect &region, bool) {
+        return searchSingle(templateMat, targetMat(region), options, level);
+    }, level == 0);
+}
+
+std::vector<MatchResult> TemplateMatcher::matchTemplateMultiple(
+    const ImageView &match_template,
+    const ImageView &match_target,
+    const MatchOptions &options
+) {
+    const cv::Mat templateMat = viewMat(match_template, false);
+    const cv::Mat targetMat = viewMat(match_target, false);
+
+    return matchesInRegions(templateMat.size(), targetMat.size(), options, [&](const cv::Rect &region, bool) {
+        cv::Mat query = templateMat;
+        cv::Mat target = targetMat(region);
+        return scoreMap(query, target, options);
+    });
+}
+
+MatchResult TemplateMatcher::matchTemplateSingle(
+    const PreparedTemplate &match_template,
+    const Image &match_target
+) {
+    return preparedMatchSingle(requireState(match_template.state_), PreparedTarget(match_target, false), match_template.options());
+}
+
+std::vector<MatchResult> TemplateMatcher::matchTemplateMultiple(
+    const PreparedTemplate &match_template,
+    const Image &match_target
+) {
+    return preparedMatchMultiple(requireState(match_template.state_), PreparedTarget(match_target, false), match_template.options());
+}
+
+MatchResult TemplateMatcher::matchTemplateSingle(
+    const PreparedTemplate &match_template,
+    const ImageView &match_target
+) {
+    return preparedMatchSingle(requireState(match_template.state_), PreparedTarget(match_target, false), match_template.options());
+}
+
+std::vector<MatchResult> TemplateMatcher::matchTemplateMultiple(
+    const PreparedTemplate &match_template,
+    const ImageView &match_target
+) {
+    return preparedMatchMultiple(requireState(match_template.state_), PreparedTarget(match_target, false), match_template.options());
+}
+
+std::vector<std::optional<MatchResult>> TemplateMatcher::matchMany(
+    const std::vector<PreparedTemplate> &match_templates,
+    const Image &match_target
+) {
+    return matchEach(match_templates.size(), match_target,
+                     [&](int i) -> const auto & { return match_templates[i].state_; },
+                     [&](int i) -> const MatchOptions & { return match_templates[i].options(); });
+}
+
+std::vector<std::optional<MatchResult>> TemplateMatcher::matchMany(
+    const std::vector<PreparedTemplate> &match_templates,
+    const Image &match_target,
+    const MatchOptions &options
+) {
+    return matchEach(match_templates.size(), match_target,
+                     [&](int i) -> const auto & { return match_templates[i].state_; },
+                     [&](int) -> const MatchOptions & { return options; });
+}
+
+std::vector<std::optional<MatchResult>> TemplateMatcher::matchMany(
+    const std::vector<PreparedTemplate> &match_templates,
+    const ImageView &match_target
+) {
+    return matchEach(match_templates.size(), match_target,
+                     [&](int i) -> const auto & { return match_templates[i].state_; },
+                     [&](int i) -> const MatchOptions & { return match_templates[i].options(); });
+}
+
+std::vector<std::optional<MatchResult>> TemplateMatcher::matchMany(
+    const std::vector<PreparedTemplate> &match_templates,
+    const ImageView &match_target,
+    const MatchOptions &options
+) {
+    return matchEach(match_templates.size(), match_target,
+                     [&](int i) -> const auto & { return match_templates[i].state_; },
+                     [&](int) -> const MatchOptions & { return options; });
+}
@@ -0,0 +1,232 @@
+#include "LibGraphics/memory/BufferPool.hpp"
+
+#include <array>
+#include <initializer_list>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace LibGraphics::Memory {
+
+    namespace {
+        constexpr size_t HugePageSize = size_t(2) << 20;
+        constexpr size_t ThreadCacheBytes = size_t(64) << 20;
+        constexpr size_t SmallBlockBytes = 1024;
+
+        std::atomic<uint64_t> nextPoolId{1};
+    }
+
+    // A handful of recently freed blocks per thread, bound to one pool at a time. Small blocks
+    // (the PixelBuffer headers) have slots of their own, so freeing a buffer's header never pushes
+    // its pixels out of the cache.
+    struct BufferPool::ThreadCache {
+        static constexpr int Slots = 4;
+
+        struct Entry {
+            void *ptr = nullptr;
+            size_t bytes = 0;
+        };
+
+        struct Bin {
+            std::array<Entry, Slots> entries{};
+            int count = 0;
+
+            void *take(size_t classBytes) noexcept {
+                for (int i = count - 1; i >= 0; --i) {
+                    if (entries[i].bytes == classBytes) {
+                        void *ptr = entries[i].ptr;
+                        entries[i] = entries[--count];
+                        return ptr;
+                    }
+                }
+                return nullptr;
+            }
+        };
+
+        uint64_t poolId = 0;
+        std::weak_ptr<BufferPool> pool;
+        Bin small;
+        Bin large;
+        size_t bytes = 0;
+
+        Bin &binFor(size_t classBytes) noexcept {
+            return classBytes <= SmallBlockBytes ? small : large;
+        }
+
+        void *take(size_t classBytes) noexcept {
+            void *ptr = binFor(classBytes).take(classBytes);
+            if (ptr) bytes -= classBytes;
+            return ptr;
+        }
+
+        bool put(void *ptr, size_t classBytes) noexcept {
+            Bin &bin = binFor(classBytes);
+            if (bin.count == Slots || bytes + classBytes > ThreadCacheBytes) return false;
+
+            bin.entries[bin.count++] = {ptr, classBytes};
+            bytes += classBytes;
+            return true;
+        }
+
+        void flush() noexcept {
+            const auto owner = pool.lock();
+
+            for (Bin *bin: {&small, &large}) {
+                for (int i = 0; i < bin->count; ++i) {
+                    // Pool blocks are plain aligned allocations, so they can be freed without the pool.
+                    if (!owner || !owner->cache(bin->entries[i].ptr, bin->entries[i].bytes)) {
+                        alignedFree(bin->entries[i].ptr);
+                        if (owner) owner->released_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                bin->count = 0;
+            }
+
+            bytes = 0;
+        }
+
+        ~ThreadCache() {
+            flush();
+        }
+    };
+
+    BufferPool::BufferPool(BufferPoolOptions options)
+        : options_(options), id_(nextPoolId.fetch_add(1, std::memory_order_relaxed)) {}
+
+    BufferPool::~BufferPool() {
+        trim();
+    }
+
+    size_t BufferPool::sizeClass(size_t bytes) {
+        if (bytes <= 64) return 64;
+
+        // Four classes per power of two keeps the rounding waste under 25%.
+        size_t base = 64;
+        while ((base << 1) < bytes) base <<= 1;
+
+        const size_t step = base / 4;
+        return base + (bytes - base + step - 1) / step * step;
+    }
+
+    BufferPool::ThreadCache *BufferPool::threadCache() noexcept {
+        static thread_local ThreadCache local;
+
+        if (local.poolId != id_) {
+            // Pools that are not owned by a shared_ptr only use the shared size classes.
+            auto self = weak_from_this().lock();
+            if (!self) return nullptr;
+
+            local.flush();
+            local.poolId = id_;
+            local.pool = self;
+        }
+
+        return &local;
+    }
+
+    void *BufferPool::allocate(size_t bytes) {
+        const size_t classBytes = sizeClass(bytes);
+
+        if (ThreadCache *local = threadCache()) {
+            if (void *ptr = local->take(classBytes)) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                threadHits_.fetch_add(1, std::memory_order_relaxed);
+                return ptr;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = free_.find(classBytes);
+
+            if (it != free_.end() && !it->second.empty()) {
+                void *ptr = it->second.back();
+                it->second.pop_back();
+                cachedBytes_ -= classBytes;
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return ptr;
+            }
+        }
+
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return allocateFromSystem(classBytes);
+    }
+
+    void BufferPool::deallocate(void *ptr, size_t bytes) noexcept {
+        if (!ptr) return;
+
+        const size_t classBytes = sizeClass(bytes);
+
+        if (ThreadCache *local = threadCache()) {
+            if (local->put(ptr, classBytes)) return;
+        }
+
+        if (!cache(ptr, classBytes)) {
+            alignedFree(ptr);
+            released_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void *BufferPool::allocateFromSystem(size_t classBytes) {
+        if (options_.hugePages && classBytes >= options_.hugePageThreshold) {
+            void *ptr = alignedAlloc(classBytes, HugePageSize);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            madvise(ptr, classBytes, MADV_HUGEPAGE);
+#endif
+            return ptr;
+        }
+
+        return alignedAlloc(classBytes);
+    }
+
+    bool BufferPool::cache(void *ptr, size_t classBytes) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (cachedBytes_ + classBytes > options_.maxCachedBytes) return false;
+
+        try {
+            free_[classBytes].push_back(ptr);
+        } catch (...) {
+            return false;
+        }
+
+        cachedBytes_ += classBytes;
+        return true;
+    }
+
+    void BufferPool::trim() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto &[classBytes, blocks]: free_) {
+            for (void *ptr: blocks) alignedFree(ptr);
+            blocks.clear();
+        }
+
+        cachedBytes_ = 0;
+    }
+
+    BufferPoolStats BufferPool::stats() const {
+        BufferPoolStats out;
+        out.hits = hits_.load(std::memory_order_relaxed);
+        out.threadHits = threadHits_.load(std::memory_order_relaxed);
+        out.misses = misses_.load(std::memory_order_relaxed);
+        out.released = released_.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.cachedBytes = cachedBytes_;
+        return out;
+    }
+
+    void BufferPool::resetStats() {
+        hits_ = 0;
+        threadHits_ = 0;
+        misses_ = 0;
+        released_ = 0;
+    }
+
+    std::shared_ptr<BufferPool> BufferPool::shared() {
+        static const std::shared_ptr<BufferPool> instance = std::make_shared<BufferPool>();
+        return instance;
+    }
+}
@@ -0,0 +1,51 @@
+#include "LibGraphics/memory/PixelAllocator.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace LibGraphics::Memory {
+
+    namespace {
+        class HeapAllocator final : public PixelAllocator {
+        public:
+            void *allocate(size_t bytes) override {
+                return alignedAlloc(bytes);
+            }
+
+            void deallocate(void *ptr, size_t) noexcept override {
+                alignedFree(ptr);
+            }
+        };
+    }
+
+    void *alignedAlloc(size_t bytes, size_t alignment) {
+        // aligned_alloc wants the size to be a multiple of the alignment.
+        const size_t rounded = (bytes + alignment - 1) / alignment * alignment;
+
+#ifdef _WIN32
+        void *ptr = _aligned_malloc(rounded, alignment);
+#else
+        void *ptr = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+#endif
+
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+
+    void alignedFree(void *ptr) noexcept {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    std::shared_ptr<PixelAllocator> PixelAllocator::heap() {
+        static const std::shared_ptr<PixelAllocator> instance = std::make_shared<HeapAllocator>();
+        return instance;
+    }
+}
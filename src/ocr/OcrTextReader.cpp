@@ -25,14 +25,13 @@ namespace LibGraphics::Ocr {
         return trimmed;
     }
 
-    OcrResult OcrTextReader::ReadFromImage(const Image &image, const char &language) {
+    OcrResult OcrTextReader::ReadFromImage(const ImageView &image, const char &language) {
         OcrResult result = {"", 0.0f};
         Pix *pix = nullptr;
         tesseract::TessBaseAPI *api = nullptr;
 
         try {
-            Image imageCopy = image.clone();
-            pix = Converter::imageToPix(imageCopy); // may throw
+            pix = Converter::viewToPix(image); // may throw
 
             api = new tesseract::TessBaseAPI();
             if (api->Init(NULL, &language)) {
@@ -0,0 +1,289 @@
+#include "LibGraphics/type/PixelBuffer.hpp"
+#include "LibGraphics/memory/PixelAllocator.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+using LibGraphics::Memory::PixelAllocator;
+
+namespace LibGraphics::Type {
+
+    namespace {
+        std::shared_ptr<PixelAllocator> &allocatorSlot() {
+            static std::shared_ptr<PixelAllocator> slot = PixelAllocator::heap();
+            return slot;
+        }
+    }
+
+    void PixelBuffer::setDefaultAllocator(std::shared_ptr<PixelAllocator> allocator) {
+        std::atomic_store(&allocatorSlot(), allocator ? std::move(allocator) : PixelAllocator::heap());
+    }
+
+    std::shared_ptr<PixelAllocator> PixelBuffer::defaultAllocator() {
+        return std::atomic_load(&allocatorSlot());
+    }
+
+    PixelBuffer::PixelBuffer(size_t size, uint8_t value) {
+        if (size == 0) return;
+
+        block_ = createBlock(size);
+        block_->size = size;
+        std::memset(block_->bytes, value, size);
+    }
+
+    PixelBuffer::PixelBuffer(const uint8_t *first, const uint8_t *last) {
+        const auto size = static_cast<size_t>(last - first);
+        if (size == 0) return;
+
+        block_ = createBlock(size);
+        block_->size = size;
+        std::memcpy(block_->bytes, first, size);
+    }
+
+    PixelBuffer::PixelBuffer(std::initializer_list<uint8_t> values)
+        : PixelBuffer(values.begin(), values.end()) {}
+
+    PixelBuffer::PixelBuffer(std::vector<uint8_t> bytes) {
+        if (bytes.empty()) return;
+
+        block_ = createBlock(0);
+        block_->adopted = std::move(bytes);
+        block_->bytes = block_->adopted.data();
+        block_->size = block_->adopted.size();
+        block_->capacity = block_->adopted.size();
+    }
+
+    PixelBuffer PixelBuffer::uninitialized(size_t size) {
+        PixelBuffer out;
+        if (size == 0) return out;
+
+        out.block_ = createBlock(size);
+        out.block_->size = size;
+        return out;
+    }
+
+    PixelBuffer PixelBuffer::adopt(uint8_t *bytes, size_t size, Deleter deleter) {
+        PixelBuffer out;
+        if (!bytes) return out;
+
+        try {
+            out.block_ = createBlock(0);
+        } catch (...) {
+            if (deleter) deleter(bytes);
+            throw;
+        }
+
+        out.block_->bytes = bytes;
+        out.block_->size = size;
+        out.block_->capacity = size;
+        out.block_->deleter = deleter;
+        return out;
+    }
+
+    PixelBuffer::PixelBuffer(const PixelBuffer &other) noexcept : block_(other.block_) {
+        if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PixelBuffer::PixelBuffer(PixelBuffer &&other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+
+    PixelBuffer::~PixelBuffer() {
+        release(block_);
+    }
+
+    PixelBuffer &PixelBuffer::operator=(const PixelBuffer &other) noexcept {
+        if (block_ == other.block_) return *this;
+
+        if (other.block_) other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+        release(block_);
+        block_ = other.block_;
+        return *this;
+    }
+
+    PixelBuffer &PixelBuffer::operator=(PixelBuffer &&other) noexcept {
+        if (this != &other) {
+            release(block_);
+            block_ = std::exchange(other.block_, nullptr);
+        }
+        return *this;
+    }
+
+    PixelBuffer &PixelBuffer::operator=(std::initializer_list<uint8_t> values) {
+        assign(values.begin(), values.end());
+        return *this;
+    }
+
+    void PixelBuffer::resize(size_t size) {
+        resize(size, 0);
+    }
+
+    void PixelBuffer::resize(size_t size, uint8_t value) {
+        if (size == this->size()) {
+            detach();
+            return;
+        }
+
+        Block *block = ownBlock();
+        if (size > block->capacity)
+            reallocate(block, size, true);
+
+        if (size > block->size)
+            std::memset(block->bytes + block->size, value, size - block->size);
+
+        block->size = size;
+        block->attachment.reset();
+    }
+
+    void PixelBuffer::assign(size_t size, uint8_t value) {
+        if (isShared()) {
+            // No point in copying bytes that are about to be overwritten.
+            *this = PixelBuffer(size, value);
+            return;
+        }
+
+        Block *block = ownBlock();
+        if (size > block->capacity)
+            reallocate(block, size, false);
+
+        if (size > 0)
+            std::memset(block->bytes, value, size);
+
+        block->size = size;
+        block->attachment.reset();
+    }
+
+    void PixelBuffer::assign(const uint8_t *first, const uint8_t *last) {
+        if (isShared() || (block_ && static_cast<size_t>(last - first) > block_->capacity)) {
+            // Build the new storage before dropping the old one, `first` may point into it.
+            *this = PixelBuffer(first, last);
+            return;
+        }
+
+        Block *block = ownBlock();
+        const auto size = static_cast<size_t>(last - first);
+        if (size > block->capacity)
+            reallocate(block, size, false);
+
+        if (size > 0)
+            std::memmove(block->bytes, first, size);
+
+        block->size = size;
+        block->attachment.reset();
+    }
+
+    void PixelBuffer::reserve(size_t capacity) {
+        Block *block = ownBlock();
+        if (capacity > block->capacity)
+            reallocate(block, capacity, true);
+
+        block->attachment.reset();
+    }
+
+    void PixelBuffer::clear() {
+        release(block_);
+        block_ = nullptr;
+    }
+
+    std::shared_ptr<void> PixelBuffer::attachment() const {
+        return block_ ? std::atomic_load(&block_->attachment) : nullptr;
+    }
+
+    void PixelBuffer::setAttachment(std::shared_ptr<void> value) const {
+        if (block_) std::atomic_store(&block_->attachment, std::move(value));
+    }
+
+    bool PixelBuffer::compareExchangeAttachment(std::shared_ptr<void> &expected, std::shared_ptr<void> desired) const {
+        if (!block_) {
+            expected = nullptr;
+            return false;
+        }
+
+        return std::atomic_compare_exchange_strong(&block_->attachment, &expected, std::move(desired));
+    }
+
+    void PixelBuffer::detachSlow() {
+        Block *copy = createBlock(block_->size);
+        copy->size = block_->size;
+        std::memcpy(copy->bytes, block_->bytes, block_->size);
+
+        release(block_);
+        block_ = copy;
+    }
+
+    PixelBuffer::Block *PixelBuffer::ownBlock() {
+        if (!block_)
+            block_ = createBlock(0);
+        else
+            detach();
+
+        return block_;
+    }
+
+    PixelBuffer::Block *PixelBuffer::createBlock(size_t capacity) {
+        std::shared_ptr<PixelAllocator> allocator = defaultAllocator();
+
+        // The header comes from the same allocator so a pooled steady state never hits malloc.
+        void *memory = allocator->allocate(sizeof(Block));
+        Block *block = new (memory) Block();
+        block->allocator = std::move(allocator);
+
+        if (capacity > 0) {
+            try {
+                block->bytes = static_cast<uint8_t *>(block->allocator->allocate(capacity));
+                block->capacity = capacity;
+            } catch (...) {
+                auto owner = std::move(block->allocator);
+                block->~Block();
+                owner->deallocate(memory, sizeof(Block));
+                throw;
+            }
+        }
+
+        return block;
+    }
+
+    void PixelBuffer::reallocate(Block *block, size_t capacity, bool preserve) {
+        auto *bytes = static_cast<uint8_t *>(block->allocator->allocate(capacity));
+
+        if (preserve && block->size > 0)
+            std::memcpy(bytes, block->bytes, std::min(block->size, capacity));
+
+        freeBytes(block);
+        block->bytes = bytes;
+        block->capacity = capacity;
+    }
+
+    void PixelBuffer::freeBytes(Block *block) noexcept {
+        if (!block->adopted.empty()) {
+            std::vector<uint8_t>().swap(block->adopted);
+        } else if (block->deleter) {
+            block->deleter(block->bytes);
+            block->deleter = nullptr;
+        } else if (block->bytes) {
+            block->allocator->deallocate(block->bytes, block->capacity);
+        }
+
+        block->bytes = nullptr;
+        block->capacity = 0;
+    }
+
+    void PixelBuffer::release(Block *block) noexcept {
+        if (!block || block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+        freeBytes(block);
+
+        auto allocator = std::move(block->allocator);
+        block->~Block();
+        allocator->deallocate(block, sizeof(Block));
+    }
+
+    bool operator==(const PixelBuffer &lhs, const PixelBuffer &rhs) {
+        if (lhs.block_ == rhs.block_) return true;
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    bool operator==(const PixelBuffer &lhs, const std::vector<uint8_t> &rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+}
@@ -10,16 +10,24 @@ using LibGraphics::Image;
 
 namespace LibGraphics::Utils {
 
-    Pix *Converter::imageToPix(Image &image) {
+    Pix *Converter::imageToPix(const Image &image) {
+        if (image.data.empty() || image.width <= 0 || image.height <= 0) {
+            throw std::runtime_error("Invalid image dimensions or empty data");
+        }
+
+        return viewToPix(image.view());
+    }
+
+    Pix *Converter::viewToPix(const ImageView &view) {
         // Note: RGBA is not supported, instead, conversion to RGB is forced.
         Pix *pix = nullptr;
 
-        if (image.data.empty() || image.width <= 0 || image.height <= 0) {
+        if (!view.isValid()) {
             throw std::runtime_error("Invalid image dimensions or empty data");
         }
 
-        if (image.channels == 1) {
-            pix = pixCreate(image.width, image.height, 8);
+        if (view.channels == 1) {
+            pix = pixCreate(view.width, view.height, 8);
             if (!pix) {
                 throw std::runtime_error("Failed to create grayscale Pix");
             }
@@ -27,13 +35,13 @@ namespace LibGraphics::Utils {
             l_uint8 *pixData = reinterpret_cast<l_uint8 *>(pixGetData(pix));
             int wpl = pixGetWpl(pix);
 
-            for (int y = 0; y < image.height; ++y) {
-                const uint8_t *srcRow = &image.data[y * image.width];
-                memcpy(pixData + y * wpl * 4, srcRow, image.width);
+            for (int y = 0; y < view.height; ++y) {
+                const uint8_t *srcRow = view.rowPtr(y);
+                memcpy(pixData + y * wpl * 4, srcRow, view.width);
             }
-        } else if (image.channels == 3 || image.channels == 4) {
+        } else if (view.channels == 3 || view.channels == 4) {
 
-            pix = pixCreate(image.width, image.height, 32);
+            pix = pixCreate(view.width, view.height, 32);
             if (!pix) {
                 throw std::runtime_error("Failed to create RGB Pix");
             }
@@ -41,16 +49,18 @@ namespace LibGraphics::Utils {
             l_uint32 *pixData = reinterpret_cast<l_uint32 *>(pixGetData(pix));
             int wpl = pixGetWpl(pix);
 
-            for (int y = 0; y < image.height; ++y) {
-                for (int x = 0; x < image.width; ++x) {
-                    int idx = (y * image.width + x) * image.channels;
-                    l_uint8 r = image.data[idx];
-                    l_uint8 g = image.data[idx + 1];
-                    l_uint8 b = image.data[idx + 2];
-                    l_uint8 a = image.channels == 4 ? image.data[idx + 3] : 255;
+            for (int y = 0; y < view.height; ++y) {
+                const uint8_t *srcRow = view.rowPtr(y);
+
+                for (int x = 0; x < view.width; ++x) {
+                    const uint8_t *px = srcRow + x * view.channels;
+                    l_uint8 r = px[0];
+                    l_uint8 g = px[1];
+                    l_uint8 b = px[2];
+                    l_uint8 a = view.channels == 4 ? px[3] : 255;
 
                     // Optional: un-premultiply if needed
-                    if (image.channels == 4 && a > 0 && a < 255) {
+                    if (view.channels == 4 && a > 0 && a < 255) {
                         float alphaFactor = a / 255.0f;
                         r = static_cast<l_uint8>(std::min(255.0f, r / alphaFactor));
                         g = static_cast<l_uint8>(std::min(255.0f, g / alphaFactor));
@@ -62,7 +72,7 @@ namespace LibGraphics::Utils {
                 }
             }
         } else {
-            throw std::runtime_error("Unsupported channel count: " + std::to_string(image.channels));
+            throw std::runtime_error("Unsupported channel count: " + std::to_string(view.channels));
         }
 
         pixEndianByteSwap(pix);
@@ -139,7 +149,7 @@ namespace LibGraphics::Utils {
         }
 
         // Wrap raw data into a Mat header (no copy yet)
-        cv::Mat mat(image.height, image.width, cvType, const_cast<uint8_t *>(image.data.data()));
+        cv::Mat mat(image.height, image.width, cvType, const_cast<uint8_t *>(image.data.data()), image.rowStride());
 
         // Convert RGB to BGR if needed
         if (image.channels == 3) {
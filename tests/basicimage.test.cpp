@@ -0,0 +1,97 @@
+#include "LibGraphics/BasicImage.hpp"
+#include "LibGraphics/Image.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace LibGraphics;
+using Catch::Matchers::WithinAbs;
+
+static Image makeFrame(int w, int h, int c, uint8_t start) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(w) * h * c);
+    for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = static_cast<uint8_t>(start + i);
+    return Image(w, h, c, std::move(pixels));
+}
+
+TEST_CASE("BasicImage has a typed mat over its pixels", "[BasicImage]") {
+    ImageU16 img(4, 3, 3, uint16_t{1000});
+
+    cv::Mat m = img.mat();
+    REQUIRE(m.type() == CV_16UC(3));
+    REQUIRE(m.cols == 4);
+    REQUIRE(m.rows == 3);
+    REQUIRE(reinterpret_cast<const uint16_t*>(m.data) == img.data());
+
+    img.at(1, 2, 2) = 7;
+    REQUIRE(m.at<cv::Vec<uint16_t, 3>>(2, 1)[2] == 7);
+
+    REQUIRE(ImageF32(2, 2, 1).mat().type() == CV_32FC(1));
+    REQUIRE_FALSE(ImageF32().isValid());
+}
+
+TEST_CASE("BasicImage converts to and from Image", "[BasicImage]") {
+    const Image frame = makeFrame(5, 4, 3, 10);
+
+    const ImageF32 unit = ImageF32::from(frame, 1.0 / 255);
+    REQUIRE_THAT(unit.at(0, 0, 0), WithinAbs(10.0 / 255, 1e-6));
+    REQUIRE_THAT(unit.at(4, 3, 2), WithinAbs(frame.data[frame.data.size() - 1] / 255.0, 1e-6));
+
+    const Image back = unit.toImage(255);
+    REQUIRE(std::vector<uint8_t>(back.data.begin(), back.data.end()) ==
+            std::vector<uint8_t>(frame.data.begin(), frame.data.end()));
+
+    // Padded rows come in like packed ones.
+    const ImageU16 wide = ImageU16::from(frame.aligned(), 256);
+    REQUIRE(wide.at(4, 3, 2) == frame.data[frame.data.size() - 1] * 256);
+    REQUIRE(wide.convert<uint8_t>(1.0 / 256).pixels() == ImageU8::from(frame).pixels());
+}
+
+TEST_CASE("BasicImage saturates integer results", "[BasicImage]") {
+    ImageU8 a(2, 2, 1, uint8_t{200});
+    a += ImageU8(2, 2, 1, uint8_t{100});
+    REQUIRE(a.at(0, 0) == 255);
+
+    a -= ImageU8(2, 2, 1, uint8_t{255});
+    REQUIRE(a.at(1, 1) == 0);
+
+    ImageF32 f(1, 1, 1, 2.0f);
+    REQUIRE(f.toImage(200).data[0] == 255);
+    REQUIRE(ImageF32(1, 1, 1, -3.0f).toImage().data[0] == 0);
+}
+
+TEST_CASE("BasicImage averages frames in place", "[BasicImage]") {
+    ImageF32 sum(3, 2, 3);
+    const float* storage = sum.data();
+
+    for (uint8_t start: {0, 30, 60})
+        sum.accumulate(makeFrame(3, 2, 3, start));
+    sum *= 1.0 / 3;
+
+    REQUIRE(sum.data() == storage);
+    REQUIRE_THAT(sum.at(0, 0, 0), WithinAbs(30.0, 1e-5));
+    REQUIRE(sum.toImage().data[5] == 35);
+}
+
+TEST_CASE("BasicImage absdiff and shape checks", "[BasicImage]") {
+    const ImageF32 a = ImageF32::from(makeFrame(4, 4, 1, 0));
+    const ImageF32 b = ImageF32::from(makeFrame(4, 4, 1, 5));
+
+    ImageF32 diff;
+    ImageF32::absdiff(a, b, diff);
+    REQUIRE(diff.at(3, 3) == 5.0f);
+
+    const float* storage = diff.data();
+    ImageF32::absdiff(b, a, diff);
+    REQUIRE(diff.data() == storage);
+
+    REQUIRE((b - a).at(0, 0) == 5.0f);
+    REQUIRE((a * 2).at(1, 0) == 2.0f);
+
+    REQUIRE_THROWS_AS(a + ImageF32(4, 4, 3), std::invalid_argument);
+    REQUIRE_THROWS_AS(ImageF32(4, 4, 1).accumulate(makeFrame(4, 3, 1, 0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(ImageU16(2, 2, 2, std::vector<uint16_t>(3)), std::invalid_argument);
+    REQUIRE_THROWS_AS(ImageF32().convert<uint8_t>(), std::invalid_argument);
+}
@@ -96,3 +96,25 @@ TEST_CASE("background_color_change_right: returns -1 if there was no color chang
     Image img = Image::load("../tests/assets/strips/10x1blank.png");
     REQUIRE(BackgroundScanner::background_color_change_right(img, 0, 0, 15, false) == -1);
 }
+
+TEST_CASE("background_color_change: Image and ImageView scans agree", "[BackgroundScanner]") {
+    Image img = Image::load("../tests/assets/strips/up_1x10p8.png");
+    REQUIRE(BackgroundScanner::background_color_change_up(img, 0, 9, 10, false) ==
+            BackgroundScanner::background_color_change_up(img.view(), 0, 9, 10, false));
+}
+
+TEST_CASE("background_color_change: scans the first channel of padded images in place", "[BackgroundScanner]") {
+    Image img = Image::allocate(4, 6, 3, true);
+    for (int y = 0; y < img.height; ++y) {
+        uint8_t* row = img.rowPtr(y);
+        for (int x = 0; x < img.width; ++x) {
+            row[x * 3] = y < 4 ? 10 : 200;   // red changes below row 3
+            row[x * 3 + 1] = static_cast<uint8_t>(y); // green changes every row and is ignored
+            row[x * 3 + 2] = 0;
+        }
+    }
+
+    REQUIRE(BackgroundScanner::background_color_change_down(img, 1, 0, 10, false) == 4);
+    REQUIRE(BackgroundScanner::background_color_change_up(img.view(), 1, 5, 10, false) == 2);
+    REQUIRE_THROWS_AS(BackgroundScanner::background_color_change_up(Image(), 0, 0, 1, false), std::runtime_error);
+}
@@ -2,6 +2,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <array>
+#include <vector>
+
 using LibGraphics::Color::Information;
 
 TEST_CASE("Color greenish checks", "[Information][is_greenish]") {
@@ -69,5 +72,21 @@ TEST_CASE("Color white checks - brightness + min component + chroma") {
     }
 }
 
+TEST_CASE("Color masks match the per-pixel checks", "[Information][mask]") {
+    const std::vector<std::array<uint8_t, 3>> colors = {
+        {112, 141, 0}, {120, 150, 10}, {10, 10, 10}, {255, 255, 255}, {230, 235, 240}, {230, 230, 250}, {219, 255, 255}
+    };
+    std::vector<uint8_t> pixels;
+    for (const auto& c: colors) pixels.insert(pixels.end(), c.begin(), c.end());
+    const LibGraphics::Image img(static_cast<int>(colors.size()), 1, 3, pixels);
 
+    const cv::Mat green = Information::greenish_mask(img);
+    const cv::Mat white = Information::white_mask(img);
+    REQUIRE(green.type() == CV_8UC1);
 
+    for (int x = 0; x < img.width; ++x) {
+        const auto& c = colors[x];
+        REQUIRE((green.at<uint8_t>(0, x) == 255) == Information::is_greenish(c[0], c[1], c[2]));
+        REQUIRE((white.at<uint8_t>(0, x) == 255) == Information::is_white(c[0], c[1], c[2]));
+    }
+}
@@ -8,6 +8,10 @@
 #include <stdexcept>
 #include <string>
 #include <array>
+#include <utility>
+#include <thread>
+#include <atomic>
+#include <cstdint>
 
 using namespace LibGraphics;
 
@@ -139,6 +143,232 @@ TEST_CASE("Image::clone creates deep copy", "[Image][clone]") {
     REQUIRE(copy.data[0] == 1);
 }
 
+TEST_CASE("Image copies share pixels until written", "[Image][clone][cow]") {
+    Image img(4, 4, 3, std::vector<uint8_t>(4 * 4 * 3, 10));
+    Image copy = img.clone();
+
+    REQUIRE(copy.data.constData() == img.data.constData());
+
+    const Image& shared = copy;
+    REQUIRE(shared.matGray().data == std::as_const(img).matGray().data);
+
+    img.redact(Rect{0, 0, 1, 1}, 0);
+
+    REQUIRE(copy.data.constData() != img.data.constData());
+    REQUIRE(copy.getRGB(0, 0)[0] == 10);
+    REQUIRE(img.getRGB(0, 0)[0] == 0);
+    REQUIRE(shared.matGray().at<uint8_t>(0, 0) == 10);
+    REQUIRE(std::as_const(img).matGray().at<uint8_t>(0, 0) == 0);
+}
+
+TEST_CASE("Image caches build once when read from many threads", "[Image][cache][threads]") {
+    const Image frame(64, 48, 3, std::vector<uint8_t>(64 * 48 * 3, 90));
+    const Image copy = frame;
+
+    constexpr int threadCount = 8;
+    std::vector<const uint8_t*> colors(threadCount);
+    std::vector<const uint8_t*> grays(threadCount);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&, i] {
+            // Half the threads go through a copy that shares the pixels, and with them the cache.
+            const Image& target = i % 2 == 0 ? frame : copy;
+            grays[i] = target.matGray().data;
+            colors[i] = target.mat().data;
+        });
+    }
+
+    for (auto& thread: threads) thread.join();
+
+    for (int i = 1; i < threadCount; ++i) {
+        REQUIRE(grays[i] == grays[0]);
+        REQUIRE(colors[i] == colors[0]);
+    }
+
+    REQUIRE(colors[0] == frame.data.constData());
+    REQUIRE(frame.matGray().at<uint8_t>(10, 10) == 90);
+}
+
+TEST_CASE("Image::redact patches the gray cache in place", "[Image][cache][redact]") {
+    Image img = Image::load("../tests/assets/image/tux.png");
+    const uint8_t* gray = std::as_const(img).matGray().data;
+
+    img.redact(Rect{10, 20, 50, 20}, 0);
+    img.redact(std::vector<Rect>{{-5, -5, 10, 10}, {img.width - 3, img.height - 3, 10, 10}}, 255);
+
+    // Same plane, patched rather than rebuilt, and identical to a fresh conversion.
+    const cv::Mat& patched = std::as_const(img).matGray();
+    REQUIRE(patched.data == gray);
+
+    const Image fresh(img.width, img.height, img.channels, img.data.toVector());
+    REQUIRE(cv::norm(patched, fresh.matGray(), cv::NORM_INF) == 0);
+    REQUIRE(patched.at<uint8_t>(25, 30) == 0);
+    REQUIRE(patched.at<uint8_t>(0, 0) == 0);
+    REQUIRE(patched.at<uint8_t>(img.height - 1, img.width - 1) == 255);
+}
+
+TEST_CASE("Images reading one buffer with different geometry keep their own caches", "[Image][cache]") {
+    std::vector<uint8_t> bytes(4 * 2 * 3);
+    for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<uint8_t>(i * 10);
+
+    const Image wide(4, 2, 3, bytes);
+    Image tall = wide;  // Same pixels, read as 2x4
+    tall.width = 2;
+    tall.height = 4;
+
+    const cv::Mat& wideGray = wide.matGray();
+    const cv::Mat& tallGray = std::as_const(tall).matGray();
+
+    // Neither read replaced the other's cache, the references stay valid.
+    REQUIRE(&wide.matGray() == &wideGray);
+    REQUIRE(&std::as_const(tall).matGray() == &tallGray);
+    REQUIRE(wideGray.cols == 4);
+    REQUIRE(tallGray.cols == 2);
+    REQUIRE(wide.plane(2).cols == 4);
+    REQUIRE(std::as_const(tall).plane(2).rows == 4);
+    REQUIRE(wide.data.constData() == tall.data.constData());
+}
+
+TEST_CASE("Image::markDirty refreshes the cache after direct writes", "[Image][cache]") {
+    Image img(4, 4, 3, std::vector<uint8_t>(4 * 4 * 3, 200));
+    REQUIRE(std::as_const(img).matGray().at<uint8_t>(1, 1) == 200);
+
+    uint8_t* px = img.data.data() + (1 * 4 + 1) * 3;
+    px[0] = px[1] = px[2] = 10;
+    img.markDirty(Rect{1, 1, 1, 1});
+
+    REQUIRE(std::as_const(img).matGray().at<uint8_t>(1, 1) == 10);
+    REQUIRE(std::as_const(img).matGray().at<uint8_t>(1, 2) == 200);
+}
+
+TEST_CASE("Image::pyramid halves each level and caches it", "[Image][pyramid]") {
+    const Image img = Image::load("../tests/assets/image/tux.png");
+    const auto levels = img.pyramid(3);
+
+    REQUIRE(levels.size() == 3);
+    REQUIRE(levels[0].data.constData() == img.data.constData());
+    REQUIRE(levels[1].width == (img.width + 1) / 2);
+    REQUIRE(levels[1].height == (img.height + 1) / 2);
+    REQUIRE(levels[2].width == (levels[1].width + 1) / 2);
+    REQUIRE(levels[2].channels == img.channels);
+
+    // Level 1 is a plain INTER_AREA halving, and asking again hands out the cached pixels.
+    REQUIRE(levels[1].data == img.resize(levels[1].width, levels[1].height).data);
+    REQUIRE(img.pyramidLevel(2).data.constData() == levels[2].data.constData());
+
+    // Copies sharing the pixels share the levels too.
+    const Image copy = img;
+    REQUIRE(copy.pyramidLevel(1).data.constData() == levels[1].data.constData());
+
+    REQUIRE_THROWS_AS(img.pyramidLevel(-1), std::invalid_argument);
+}
+
+TEST_CASE("Image::pyramid stops at 1x1", "[Image][pyramid]") {
+    const Image img(5, 3, 1, std::vector<uint8_t>(15, 40));
+    const auto levels = img.pyramid(10);
+
+    REQUIRE(levels.size() == 4);
+    REQUIRE(levels.back().width == 1);
+    REQUIRE(levels.back().height == 1);
+    REQUIRE(levels.back().data[0] == 40);
+}
+
+TEST_CASE("Image::pyramid levels are rebuilt after a mutation", "[Image][pyramid][cache]") {
+    Image img(8, 8, 3, std::vector<uint8_t>(8 * 8 * 3, 200));
+    const Image before = img.pyramidLevel(1);
+    REQUIRE(before.getRGB(0, 0)[0] == 200);
+
+    img.redact(Rect{0, 0, 2, 2}, 0);
+
+    const Image after = img.pyramidLevel(1);
+    REQUIRE(after.getRGB(0, 0)[0] == 0);
+    REQUIRE(after.getRGB(3, 3)[0] == 200);
+    REQUIRE(before.getRGB(0, 0)[0] == 200);
+}
+
+static bool rowsAligned(const Image& img) {
+    for (int y = 0; y < img.height; ++y)
+        if (reinterpret_cast<uintptr_t>(img.rowPtr(y)) % Image::RowAlignment != 0) return false;
+    return true;
+}
+
+TEST_CASE("Image::aligned pads rows and keeps the pixels", "[Image][stride]") {
+    const Image packed = Image::load("../tests/assets/image/tux.png");
+    const Image aligned = packed.aligned();
+
+    REQUIRE(aligned.isValid());
+    REQUIRE(aligned.stride == Image::alignedStride(packed.width, packed.channels));
+    REQUIRE(aligned.data.size() == aligned.stride * aligned.height);
+    REQUIRE(rowsAligned(aligned));
+
+    REQUIRE(aligned.getRGB(17, 23) == packed.getRGB(17, 23));
+    REQUIRE(aligned.packed().data == packed.data);
+    REQUIRE(aligned.aligned().data.constData() == aligned.data.constData());
+
+    // OpenCV sees the padding as the row step, not as extra pixels.
+    REQUIRE(aligned.mat().step == aligned.stride);
+    REQUIRE(cv::norm(aligned.mat(), packed.mat(), cv::NORM_INF) == 0);
+    REQUIRE(cv::norm(aligned.matGray(), packed.matGray(), cv::NORM_INF) == 0);
+    REQUIRE(aligned.matGray().step % Image::RowAlignment == 0);
+}
+
+TEST_CASE("Images derived from an aligned image stay aligned", "[Image][stride]") {
+    const Image packed = Image::load("../tests/assets/image/tux.png");
+    const Image aligned = packed.aligned();
+
+    const Image crop = aligned.crop(3, 5, 40, 30);
+    REQUIRE(crop.stride != 0);
+    REQUIRE(rowsAligned(crop));
+    REQUIRE(crop.packed().data == packed.crop(3, 5, 40, 30).data);
+
+    const Image small = aligned.resize(aligned.width / 2, aligned.height / 2);
+    REQUIRE(rowsAligned(small));
+    REQUIRE(small.packed().data == packed.resize(packed.width / 2, packed.height / 2).data);
+
+    const Image gray = aligned.toGrayscale();
+    REQUIRE(rowsAligned(gray));
+    REQUIRE(gray.packed().data == packed.toGrayscale().data);
+
+    REQUIRE(rowsAligned(aligned.pyramidLevel(1)));
+}
+
+TEST_CASE("Padded images encode like packed ones", "[Image][stride][encode]") {
+    const Image packed = Image::load("../tests/assets/image/tux.png");
+    const Image aligned = packed.aligned();
+
+    REQUIRE(aligned.encode("png") == packed.encode("png"));
+    REQUIRE(aligned.encode("bmp") == packed.encode("bmp"));
+
+    const Image loaded = Image::load_from_memory(packed.encode("png"), LoadOptions().aligned());
+    REQUIRE(loaded.stride == Image::alignedStride(packed.width, packed.channels));
+    REQUIRE(loaded.packed().data == packed.data);
+}
+
+TEST_CASE("Image stride constructor checks its layout", "[Image][stride]") {
+    // Two RGB pixels per row, padded to 8 bytes; the padding is never read.
+    const Image img(2, 2, 3, std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 99, 99, 7, 8, 9, 10, 11, 12, 99, 99}, 8);
+    REQUIRE(img.getRGB(1, 1) == std::array<uint8_t, 3>{10, 11, 12});
+    REQUIRE(img.packed().data == std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+
+    REQUIRE_THROWS_AS(Image(2, 2, 3, std::vector<uint8_t>(16), 5), std::invalid_argument);
+    REQUIRE_THROWS_AS(Image(2, 2, 3, std::vector<uint8_t>(12), 8), std::invalid_argument);
+
+    // RGBA with padding still loses its alpha channel, like packed input.
+    const Image rgba(1, 1, 4, std::vector<uint8_t>{1, 2, 3, 4, 0, 0, 0, 0}, 8);
+    REQUIRE(rgba.channels == 3);
+    REQUIRE(rgba.getRGB(0, 0) == std::array<uint8_t, 3>{1, 2, 3});
+
+    // An explicit packed RGBA stride describes the input rows, not the stripped ones.
+    const Image packedRgba(2, 2, 4, std::vector<uint8_t>{1, 2, 3, 255, 4, 5, 6, 255, 7, 8, 9, 255, 10, 11, 12, 255}, 8);
+    REQUIRE(packedRgba.channels == 3);
+    REQUIRE(packedRgba.rowStride() == 6);
+    REQUIRE(packedRgba.rowStride() * packedRgba.height == packedRgba.data.size());
+    REQUIRE(packedRgba.getRGB(1, 1) == std::array<uint8_t, 3>{10, 11, 12});
+    REQUIRE(packedRgba.mat().step == 6);
+    REQUIRE(packedRgba.packed().data == std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+}
+
 TEST_CASE("Image::load_from_memory loads valid PNG", "[image][memory]") {
     auto buffer = load_file("../tests/assets/image/tux.png");
     REQUIRE(!buffer.empty());
@@ -157,6 +387,90 @@ TEST_CASE("Image::load_from_memory throws on corrupt data", "[image][memory][err
     REQUIRE_THROWS_AS(Image::load_from_memory(corrupt), std::runtime_error);
 }
 
+TEST_CASE("Image::load applies LoadOptions", "[image][load]") {
+    const Image full = Image::load("../tests/assets/image/tux.png");
+
+    const Image gray = Image::load("../tests/assets/image/tux.png", LoadOptions().scale(2).gray());
+    REQUIRE(gray.channels == 1);
+    REQUIRE(gray.width == (full.width + 1) / 2);
+    REQUIRE(gray.height == (full.height + 1) / 2);
+    REQUIRE(gray.origin == "../tests/assets/image/tux.png");
+
+    // JPEG takes the turbo path when it is compiled in; dimensions must match the stb fallback.
+    const std::string jpeg = "../tests/assets/tmp/load_options.jpg";
+    REQUIRE(full.save(jpeg, 90));
+
+    const Image quarter = Image::load(jpeg, LoadOptions().scale(4));
+    REQUIRE(quarter.channels == 3);
+    REQUIRE(quarter.width == (full.width + 3) / 4);
+    REQUIRE(quarter.height == (full.height + 3) / 4);
+
+    std::filesystem::remove(jpeg);
+
+    REQUIRE_THROWS_AS(Image::load("../tests/assets/image/tux.png", LoadOptions().scale(3)), std::invalid_argument);
+}
+
+TEST_CASE("Image PNG round trip is lossless at every compression level", "[image][save]") {
+    const Image original = Image::load("../tests/assets/image/tux.png");
+    const std::string path = "../tests/assets/tmp/compression_level.png";
+    const int previous = Image::pngCompressionLevel();
+
+    for (int level: {0, 1, 6, 9}) {
+        Image::setPngCompressionLevel(level);
+        REQUIRE(Image::pngCompressionLevel() == level);
+        REQUIRE(original.save(path));
+
+        const Image decoded = Image::load(path);
+        REQUIRE(decoded.width == original.width);
+        REQUIRE(decoded.height == original.height);
+        REQUIRE(decoded.channels == original.channels);
+        REQUIRE(decoded.data == original.data);
+    }
+
+    Image::setPngCompressionLevel(42);
+    REQUIRE(Image::pngCompressionLevel() == 9);
+
+    Image::setPngCompressionLevel(previous);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Image::encode round trips through load_from_memory", "[image][encode]") {
+    const Image original = Image::load("../tests/assets/image/tux.png");
+
+    const std::vector<uint8_t> png = original.encode("png");
+    REQUIRE(!png.empty());
+
+    const Image decoded = Image::load_from_memory(png);
+    REQUIRE(decoded.width == original.width);
+    REQUIRE(decoded.height == original.height);
+    REQUIRE(decoded.data == original.data);
+
+    const std::vector<uint8_t> jpeg = original.encode(".JPEG", 80);
+    REQUIRE(jpeg.size() > 3);
+    REQUIRE(jpeg[0] == 0xFF);
+    REQUIRE(jpeg[1] == 0xD8);
+
+    REQUIRE(!original.encode("bmp").empty());
+    REQUIRE(!original.encode("tga").empty());
+    REQUIRE(Image().encode("png").empty());
+    REQUIRE_THROWS_AS(original.encode("gif"), std::invalid_argument);
+}
+
+TEST_CASE("Image::encode streams chunks to a callback", "[image][encode]") {
+    const Image original = Image::load("../tests/assets/image/tux.png");
+
+    std::vector<uint8_t> streamed;
+    int calls = 0;
+
+    REQUIRE(original.encode("jpg", [&](const uint8_t* bytes, size_t size) {
+        streamed.insert(streamed.end(), bytes, bytes + size);
+        ++calls;
+    }, 75));
+
+    REQUIRE(calls > 0);
+    REQUIRE(streamed == original.encode("jpg", 75));
+}
+
 TEST_CASE("Image constructor validates buffer size", "[image][constructor]") {
     int w = 10, h = 10, c = 3;
     std::vector<uint8_t> bad_data(w * h * c - 1); // too small
@@ -211,6 +525,21 @@ TEST_CASE("Image constructor strips alpha from RGBA", "[image][constructor]") {
     REQUIRE(pixel4[2] == 255);
 }
 
+TEST_CASE("Image strips alpha in place and leaves shared RGBA untouched", "[image][constructor]") {
+    PixelBuffer rgba{1, 2, 3, 255, 4, 5, 6, 255, 7, 8, 9, 255, 10, 11, 12, 255, 13, 14, 15, 255};
+    const uint8_t* storage = rgba.constData();
+
+    Image owned(5, 1, 4, std::move(rgba));
+    REQUIRE(owned.channels == 3);
+    REQUIRE(owned.data.constData() == storage);
+    REQUIRE(owned.data == std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15});
+
+    PixelBuffer shared{1, 2, 3, 255, 4, 5, 6, 255};
+    Image copy(2, 1, 4, shared);
+    REQUIRE(copy.data == std::vector<uint8_t>{1, 2, 3, 4, 5, 6});
+    REQUIRE(shared == std::vector<uint8_t>{1, 2, 3, 255, 4, 5, 6, 255});
+}
+
 TEST_CASE("Image constructor with invalid buffer size throws", "[Image][constructor]") {
     int w = 4, h = 4, c = 3;
     std::vector<uint8_t> bad_data(w * h * c - 1); // too small
@@ -389,6 +718,15 @@ TEST_CASE("Image::getRGB returns correct pixel values", "[image][getRGB]") {
         REQUIRE(pixel3[2] == 255);
     }
 
+    SECTION("Gray plus alpha image returns the gray value") {
+        LibGraphics::Image img(2, 1, 2, std::vector<uint8_t>{10, 255, 90, 0});
+
+        auto pixel = img.getRGB(1, 0);
+        REQUIRE(pixel[0] == 90);
+        REQUIRE(pixel[1] == 90);
+        REQUIRE(pixel[2] == 90);
+    }
+
     SECTION("Throws exception for out of bounds coordinates") {
         std::vector<uint8_t> data = {
             255, 0, 0,
@@ -489,6 +827,51 @@ TEST_CASE("Redact multiple regions", "[Image][redact]") {
     REQUIRE(untouched[0] == 255);
 }
 
+TEST_CASE("Redact with RedactOptions", "[Image][redact]") {
+    std::vector<uint8_t> pixels(8 * 8 * 3);
+    for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = static_cast<uint8_t>(i * 7);
+    const Image original(8, 8, 3, pixels);
+
+    SECTION("solid colour, overlaps painted once") {
+        Image img = original;
+        img.redact(std::vector<Rect>{{0, 0, 4, 4}, {2, 2, 4, 4}}, RedactOptions().solid(10, 20, 30));
+
+        REQUIRE(img.getRGB(3, 3) == std::array<uint8_t, 3>{10, 20, 30});
+        REQUIRE(img.getRGB(5, 5) == std::array<uint8_t, 3>{10, 20, 30});
+        REQUIRE(img.getRGB(5, 0) == original.getRGB(5, 0));
+    }
+
+    SECTION("grayscale images get the luma of the colour") {
+        Image img(4, 4, 1, std::vector<uint8_t>(16, 0));
+        img.redact(Rect{0, 0, 2, 2}, RedactOptions().solid(255, 0, 0));
+        REQUIRE(img.getRGB(1, 1)[0] == 76);
+    }
+
+    SECTION("pixelate turns each cell into one colour") {
+        Image img = original;
+        img.redact(Rect{0, 0, 4, 4}, RedactOptions().pixelate(2));
+
+        REQUIRE(img.getRGB(0, 0) == img.getRGB(1, 1));
+        REQUIRE(img.getRGB(2, 2) == img.getRGB(3, 3));
+        REQUIRE(img.getRGB(4, 4) == original.getRGB(4, 4));
+    }
+
+    SECTION("blur only touches the rectangle") {
+        Image img = original;
+        img.redact(Rect{2, 2, 3, 3}, RedactOptions().blur(1));
+
+        REQUIRE(img.getRGB(3, 3) != original.getRGB(3, 3));
+        REQUIRE(img.getRGB(1, 1) == original.getRGB(1, 1));
+        REQUIRE(img.getRGB(5, 5) == original.getRGB(5, 5));
+    }
+
+    SECTION("bad parameters throw") {
+        Image img = original;
+        REQUIRE_THROWS_AS(img.redact(Rect{0, 0, 2, 2}, RedactOptions().pixelate(0)), std::invalid_argument);
+        REQUIRE_THROWS_AS(img.redact(Rect{0, 0, 2, 2}, RedactOptions().blur(0)), std::invalid_argument);
+    }
+}
+
 //
 // FIXED mat() TESTS + NEW matGray() TESTS
 //
@@ -533,6 +916,28 @@ TEST_CASE("Image::mat cache invalidates after redact", "[Image][mat][cache]") {
     REQUIRE(after.at<cv::Vec3b>(0, 0)[0] == 0);
 }
 
+TEST_CASE("Image::mat is a view over the pixel buffer", "[Image][mat][view]") {
+    std::vector<uint8_t> pixels(4 * 4 * 3, 10);
+    Image img(4, 4, 3, pixels);
+
+    cv::Mat& m = img.mat();
+    REQUIRE(m.data == img.data.data());
+
+    m.at<cv::Vec3b>(1, 1)[0] = 99;
+    REQUIRE(img.data[(1 * 4 + 1) * 3] == 99);
+
+    SECTION("Header follows a reallocated buffer") {
+        img.data.assign(8 * 8 * 3, 20);
+        img.width = 8;
+        img.height = 8;
+
+        cv::Mat& rebuilt = img.mat();
+        REQUIRE(rebuilt.data == img.data.data());
+        REQUIRE(rebuilt.cols == 8);
+        REQUIRE(rebuilt.at<cv::Vec3b>(7, 7)[0] == 20);
+    }
+}
+
 TEST_CASE("Image::mat stays consistent after multiple calls and mutations", "[Image][mat][consistency]") {
     std::vector<uint8_t> pixels(3 * 3 * 3, 200);
     Image img(3, 3, 3, pixels);
@@ -616,6 +1021,115 @@ TEST_CASE("Image::matGray stays consistent after multiple calls and mutations",
     REQUIRE(g3.data == g2.data); // cache blijft geldig
 }
 
+TEST_CASE("Image::plane splits the channels", "[Image][plane]") {
+    std::vector<uint8_t> pixels;
+    for (int i = 0; i < 5 * 3; ++i)
+        pixels.insert(pixels.end(), {static_cast<uint8_t>(i), static_cast<uint8_t>(100 + i), static_cast<uint8_t>(200 + i / 2)});
+    Image img(5, 3, 3, pixels);
+
+    for (int c = 0; c < 3; ++c) {
+        const cv::Mat& plane = img.plane(c);
+        REQUIRE(plane.type() == CV_8UC1);
+        REQUIRE(plane.cols == 5);
+        REQUIRE(plane.rows == 3);
+        for (int y = 0; y < 3; ++y)
+            for (int x = 0; x < 5; ++x)
+                REQUIRE(plane.at<uint8_t>(y, x) == pixels[(y * 5 + x) * 3 + c]);
+    }
+
+    REQUIRE(img.plane(1).data == img.plane(1).data);
+    REQUIRE_THROWS_AS(img.plane(3), std::out_of_range);
+    REQUIRE_THROWS_AS(img.plane(-1), std::out_of_range);
+
+    Image gray(4, 4, 1, std::vector<uint8_t>(16, 9));
+    REQUIRE(gray.plane(0).data == gray.mat().data);
+}
+
+TEST_CASE("Image::plane is patched after redact", "[Image][plane][cache]") {
+    Image img(6, 6, 4, std::vector<uint8_t>(6 * 6 * 4, 200));
+    const uint8_t* before = img.plane(0).data;
+
+    img.redact(Rect{1, 1, 2, 3}, RedactOptions().solid(10, 20, 30));
+
+    REQUIRE(img.plane(0).data == before);
+    for (int c = 0; c < 4; ++c) {
+        const Image fresh(img.width, img.height, img.channels, std::vector<uint8_t>(img.data.begin(), img.data.end()));
+        REQUIRE(cv::norm(img.plane(c), fresh.plane(c), cv::NORM_INF) == 0);
+    }
+    REQUIRE(img.plane(2).at<uint8_t>(2, 1) == 30);
+    REQUIRE(img.plane(3).at<uint8_t>(2, 1) == 200);
+}
+
+TEST_CASE("Image::plane pads rows of aligned images", "[Image][plane][stride]") {
+    Image img = Image(7, 3, 3, std::vector<uint8_t>(7 * 3 * 3, 42)).aligned();
+
+    const cv::Mat& plane = img.plane(2);
+    REQUIRE(plane.cols == 7);
+    REQUIRE(plane.step[0] % Image::RowAlignment == 0);
+    REQUIRE(cv::norm(plane, cv::NORM_INF) == 42);
+}
+
+TEST_CASE("Image::row gives unchecked pixel spans", "[Image][row]") {
+    std::vector<uint8_t> pixels;
+    for (int i = 0; i < 4 * 3; ++i)
+        pixels.insert(pixels.end(), {static_cast<uint8_t>(i), static_cast<uint8_t>(2 * i), static_cast<uint8_t>(3 * i), 255});
+    const Image img = Image(4, 3, 4, pixels).aligned();
+
+    for (int y = 0; y < img.height; ++y) {
+        const ConstPixelRow row = img.row(y);
+        REQUIRE(row.width() == 4);
+        REQUIRE(row.end() - row.begin() == 4);
+
+        int x = 0;
+        for (const ConstPixelRef px: row) {
+            REQUIRE(px.rgb() == img.getRGB(x, y));
+            REQUIRE(px.alpha() == 255);
+            ++x;
+        }
+        REQUIRE(row[3][2] == img.getRGB(3, y)[2]);
+    }
+
+    REQUIRE(img.view(1, 1, 2, 2).row(1)[0].rgb() == img.getRGB(1, 2));
+    REQUIRE(Image(1, 1, 1, std::vector<uint8_t>{9}).row(0)[0].alpha() == 255);
+}
+
+TEST_CASE("Image::forEachPixel visits every pixel once", "[Image][row][parallel]") {
+    std::vector<uint8_t> pixels(64 * 48 * 3);
+    for (size_t i = 0; i < pixels.size(); ++i) pixels[i] = static_cast<uint8_t>(i * 7);
+    const Image img(64, 48, 3, pixels);
+
+    std::vector<std::atomic<int>> visits(64 * 48);
+    std::atomic<long> redSum{0};
+    img.forEachPixel([&](int x, int y, ConstPixelRef px) {
+        visits[y * 64 + x]++;
+        redSum += px[0];
+    });
+
+    long expected = 0;
+    for (size_t i = 0; i < pixels.size(); i += 3) expected += pixels[i];
+
+    REQUIRE(redSum.load() == expected);
+    for (const auto& v: visits) REQUIRE(v.load() == 1);
+
+    REQUIRE_THROWS_AS(Image().forEachPixel([](int, int, ConstPixelRef) {}), std::runtime_error);
+}
+
+TEST_CASE("Image::modifyPixels writes and refreshes the caches", "[Image][row][cache]") {
+    Image img(16, 8, 3, std::vector<uint8_t>(16 * 8 * 3, 40));
+    const Image shared = img;
+    REQUIRE(img.matGray().at<uint8_t>(0, 0) == 40);
+
+    img.modifyPixels([](int x, int, PixelRef px) {
+        if (x % 2 == 0) px[0] = px[1] = px[2] = 200;
+    });
+
+    REQUIRE(img.getRGB(0, 5) == std::array<uint8_t, 3>{200, 200, 200});
+    REQUIRE(img.getRGB(1, 5) == std::array<uint8_t, 3>{40, 40, 40});
+    REQUIRE(img.matGray().at<uint8_t>(7, 2) == 200);
+    REQUIRE(img.matGray().at<uint8_t>(7, 3) == 40);
+    REQUIRE(shared.getRGB(0, 0)[0] == 40);
+}
+
 TEST_CASE("Image::resize scales image correctly", "[Image][resize]") {
 
     SECTION("Resize RGB image 4x4 → 2x2") {
@@ -0,0 +1,66 @@
+#include "LibGraphics/Image.hpp"
+#include "LibGraphics/ImageView.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace LibGraphics;
+
+static Image makeCounting(int w, int h, int c) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(w) * h * c);
+    for (size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<uint8_t>(i);
+    return Image(w, h, c, std::move(pixels));
+}
+
+TEST_CASE("ImageView over a whole image", "[ImageView]") {
+    Image img = makeCounting(4, 3, 3);
+    ImageView v = img.view();
+
+    REQUIRE(v.isValid());
+    REQUIRE(v.pixels == img.data.constData());
+    REQUIRE(v.width == 4);
+    REQUIRE(v.height == 3);
+    REQUIRE(v.stride == 12);
+    REQUIRE(v.getRGB(2, 1) == img.getRGB(2, 1));
+}
+
+TEST_CASE("ImageView::crop does not copy", "[ImageView][crop]") {
+    Image img = makeCounting(4, 4, 1);
+    ImageView v = img.view(1, 1, 2, 2);
+
+    REQUIRE(v.isValid());
+    REQUIRE(v.pixels == img.data.constData() + 5);
+    REQUIRE(v.stride == 4);
+    REQUIRE(v.getRGB(0, 0)[0] == 5);
+    REQUIRE(v.getRGB(1, 1)[0] == 10);
+
+    SECTION("Nested crops keep the parent stride") {
+        ImageView inner = v.crop(1, 1, 1, 1);
+        REQUIRE(inner.pixels == img.data.constData() + 10);
+        REQUIRE(inner.stride == 4);
+    }
+
+    SECTION("Out-of-bounds crop returns an empty view") {
+        REQUIRE_FALSE(v.crop(1, 1, 2, 2));
+        REQUIRE_FALSE(img.view(3, 3, 2, 2));
+    }
+}
+
+TEST_CASE("ImageView::mat honours the stride", "[ImageView][mat]") {
+    Image img = makeCounting(4, 4, 3);
+    cv::Mat m = img.view(1, 2, 2, 2).mat();
+
+    REQUIRE(m.rows == 2);
+    REQUIRE(m.cols == 2);
+    REQUIRE(m.step[0] == 12);
+    REQUIRE(m.data == img.data.constData() + (2 * 4 + 1) * 3);
+}
+
+TEST_CASE("ImageView::toImage copies into a packed image", "[ImageView][toImage]") {
+    Image img = makeCounting(4, 4, 1);
+    Image copy = img.view(1, 1, 2, 2).toImage();
+
+    REQUIRE(copy.isValid());
+    REQUIRE(copy.data == std::vector<uint8_t>{5, 6, 9, 10});
+}
@@ -0,0 +1,98 @@
+#include "LibGraphics/Image.hpp"
+#include "LibGraphics/IntegralImage.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace LibGraphics;
+using Catch::Matchers::WithinAbs;
+
+static Image makeRandom(int w, int h, int c, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> pixels(static_cast<size_t>(w) * h * c);
+    for (auto& v: pixels) v = static_cast<uint8_t>(rng());
+    return Image(w, h, c, std::move(pixels));
+}
+
+// Straight loop over the pixels, the way callers used to do it.
+static std::pair<double, double> bruteForce(const Image& img, const Rect& r, int channel) {
+    double sum = 0, squares = 0;
+    for (int y = r.Y; y < r.Y + r.Height; ++y)
+        for (int x = r.X; x < r.X + r.Width; ++x) {
+            const double v = img.data[(static_cast<size_t>(y) * img.width + x) * img.channels + channel];
+            sum += v;
+            squares += v * v;
+        }
+    return {sum, squares};
+}
+
+TEST_CASE("IntegralImage sums match a pixel loop", "[IntegralImage]") {
+    const Image img = makeRandom(37, 23, 3, 1);
+    const IntegralImage table = img.integral();
+
+    REQUIRE(table.width() == 37);
+    REQUIRE(table.height() == 23);
+    REQUIRE(table.channels() == 3);
+
+    for (const Rect& r: {Rect{0, 0, 37, 23}, Rect{5, 7, 1, 1}, Rect{3, 2, 20, 11}, Rect{36, 22, 1, 1}}) {
+        for (int c = 0; c < 3; ++c) {
+            const auto [sum, squares] = bruteForce(img, r, c);
+            const double n = r.area();
+
+            REQUIRE(table.sum(r, c) == sum);
+            REQUIRE(table.squaredSum(r, c) == squares);
+            REQUIRE_THAT(table.mean(r, c), WithinAbs(sum / n, 1e-9));
+            REQUIRE_THAT(table.variance(r, c), WithinAbs(squares / n - (sum / n) * (sum / n), 1e-6));
+        }
+    }
+}
+
+TEST_CASE("IntegralImage keeps the image channel order", "[IntegralImage]") {
+    std::vector<uint8_t> pixels;
+    for (int i = 0; i < 4; ++i) pixels.insert(pixels.end(), {200, 100, 10});
+    const IntegralImage table = Image(2, 2, 3, pixels).integral();
+
+    REQUIRE(table.mean(Rect{0, 0, 2, 2}, 0) == 200);
+    REQUIRE(table.mean(Rect{0, 0, 2, 2}, 2) == 10);
+    REQUIRE(table.variance(Rect{0, 0, 2, 2}, 1) == 0);
+}
+
+TEST_CASE("IntegralImage clips rectangles and checks channels", "[IntegralImage]") {
+    const Image img = makeRandom(10, 10, 1, 2);
+    const IntegralImage table = img.integral();
+
+    REQUIRE(table.sum(Rect{-5, -5, 10, 10}) == bruteForce(img, Rect{0, 0, 5, 5}, 0).first);
+    REQUIRE(table.sum(Rect{20, 20, 5, 5}) == 0);
+    REQUIRE(table.mean(Rect{20, 20, 5, 5}) == 0);
+    REQUIRE_THROWS_AS(table.sum(Rect{0, 0, 1, 1}, 1), std::out_of_range);
+}
+
+TEST_CASE("Image::integralGray matches matGray", "[IntegralImage][Image]") {
+    const Image img = makeRandom(16, 12, 3, 3);
+    const IntegralImage table = img.integralGray();
+    const cv::Mat& gray = img.matGray();
+
+    REQUIRE(table.channels() == 1);
+    REQUIRE(table.sum(Rect{0, 0, 16, 12}) == cv::sum(gray)[0]);
+
+    // Single channel images reuse the plain tables.
+    const Image single = makeRandom(8, 8, 1, 4);
+    REQUIRE(single.integralGray().sumTable().data == single.integral().sumTable().data);
+}
+
+TEST_CASE("Image integral tables are cached and dropped on mutation", "[IntegralImage][Image][cache]") {
+    Image img(8, 8, 3, std::vector<uint8_t>(8 * 8 * 3, 100));
+    const IntegralImage before = img.integral();
+    REQUIRE(std::as_const(img).integral().sumTable().data == before.sumTable().data);
+
+    img.redact(Rect{0, 0, 4, 4}, 0);
+
+    const IntegralImage after = img.integral();
+    REQUIRE(after.mean(Rect{0, 0, 4, 4}) == 0);
+    REQUIRE(after.mean(Rect{4, 4, 4, 4}) == 100);
+    REQUIRE(before.mean(Rect{0, 0, 4, 4}) == 100);
+}
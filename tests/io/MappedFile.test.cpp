@@ -0,0 +1,40 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LibGraphics/io/MappedFile.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using LibGraphics::IO::MappedFile;
+
+TEST_CASE("MappedFile exposes the file contents", "[io][MappedFile]") {
+    const std::string path = "../tests/assets/image/tux.png";
+
+    std::ifstream in(path, std::ios::binary);
+    const std::vector<uint8_t> expected((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    REQUIRE(!expected.empty());
+
+    MappedFile file(path);
+
+    REQUIRE(file.isOpen());
+    REQUIRE(file.size() == expected.size());
+    REQUIRE(std::vector<uint8_t>(file.data(), file.data() + file.size()) == expected);
+}
+
+TEST_CASE("MappedFile reports missing and empty files", "[io][MappedFile]") {
+    MappedFile missing("../tests/assets/does-not-exist.png");
+    REQUIRE_FALSE(missing.isOpen());
+    REQUIRE(missing.size() == 0);
+
+    const std::string path = "../tests/assets/tmp/empty.bin";
+    { std::ofstream touch(path, std::ios::binary); }
+
+    {
+        MappedFile empty(path);
+        REQUIRE(empty.isOpen());
+        REQUIRE(empty.size() == 0);
+    }
+
+    std::remove(path.c_str());
+}
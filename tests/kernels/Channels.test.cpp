@@ -0,0 +1,38 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LibGraphics/kernels/Channels.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace LibGraphics::Kernels;
+
+TEST_CASE("stripAlpha kernels agree across backends, in and out of place", "[kernels][channels]") {
+    std::mt19937 rng(7);
+
+    // Pixel counts around every vector step and loop bound.
+    for (size_t pixels: {1, 4, 5, 6, 10, 11, 15, 16, 17, 31, 32, 33, 64, 1921}) {
+        std::vector<uint8_t> rgba(pixels * 4);
+        for (auto& v: rgba) v = static_cast<uint8_t>(rng());
+
+        std::vector<uint8_t> expected(pixels * 3);
+        for (size_t i = 0; i < pixels; ++i) {
+            expected[i * 3 + 0] = rgba[i * 4 + 0];
+            expected[i * 3 + 1] = rgba[i * 4 + 1];
+            expected[i * 3 + 2] = rgba[i * 4 + 2];
+        }
+
+        for (Backend backend: supportedBackends()) {
+            INFO(backendName(backend) << " pixels " << pixels);
+
+            // Exactly sized destination: the kernels must not spill past it.
+            std::vector<uint8_t> out(pixels * 3);
+            stripAlpha(backend, rgba.data(), out.data(), pixels);
+            REQUIRE(out == expected);
+
+            std::vector<uint8_t> inPlace = rgba;
+            stripAlpha(backend, inPlace.data(), inPlace.data(), pixels);
+            inPlace.resize(pixels * 3);
+            REQUIRE(inPlace == expected);
+        }
+    }
+}
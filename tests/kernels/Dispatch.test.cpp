@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LibGraphics/kernels/Dispatch.hpp"
+#include "LibGraphics/kernels/Redact.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace LibGraphics::Kernels;
+
+TEST_CASE("dispatchChannels hands the channel count over as a constant", "[kernels][dispatch]") {
+    for (int channels: {1, 2, 3, 4}) {
+        const int seen = dispatchChannels(channels, [](auto c) {
+            static_assert(decltype(c)::value >= 1 && decltype(c)::value <= 4);
+            return decltype(c)::value;
+        });
+        REQUIRE(seen == channels);
+    }
+
+    REQUIRE_THROWS_AS(dispatchChannels(0, [](auto) {}), std::invalid_argument);
+    REQUIRE_THROWS_AS(dispatchChannels(5, [](auto) {}), std::invalid_argument);
+}
+
+TEST_CASE("dispatchLayout rejects more colour channels than channels", "[kernels][dispatch]") {
+    int calls = 0;
+    dispatchLayout(4, 3, [&](auto c, auto cc) {
+        REQUIRE(decltype(c)::value == 4);
+        REQUIRE(decltype(cc)::value == 3);
+        ++calls;
+    });
+    REQUIRE(calls == 1);
+
+    REQUIRE_THROWS_AS(dispatchLayout(3, 4, [](auto, auto) {}), std::invalid_argument);
+}
+
+TEST_CASE("Span kernels handle gray plus alpha pixels", "[kernels][dispatch][redact]") {
+    // Two 2-channel rows of 4 pixels with a padded stride.
+    const size_t stride = 10;
+    std::vector<uint8_t> pixels(stride * 2, 7);
+    const uint8_t color[1] = {200};
+
+    fillSpans(pixels.data(), stride, 2, 1, mergeSpans({{1, 0, 2, 2}}, 4, 2), color);
+
+    for (int y = 0; y < 2; ++y)
+        for (int x = 0; x < 4; ++x) {
+            const uint8_t *px = pixelAt<2>(pixels.data(), stride, x, y);
+            REQUIRE(px[0] == (x == 1 || x == 2 ? 200 : 7));
+            REQUIRE(px[1] == 7);
+        }
+    REQUIRE(pixels[8] == 7);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LibGraphics/kernels/Grayscale.hpp"
+#include "LibGraphics/Image.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace LibGraphics::Kernels;
+
+namespace {
+    std::vector<uint8_t> referenceRow(const uint8_t* src, int width, int channels, ChannelOrder order) {
+        std::vector<uint8_t> out(width);
+
+        for (int x = 0; x < width; ++x) {
+            const uint8_t* px = src + x * channels;
+            if (channels < 3) out[x] = px[0];
+            else if (order == ChannelOrder::RGB) out[x] = grayPixel(px[0], px[1], px[2]);
+            else out[x] = grayPixel(px[2], px[1], px[0]);
+        }
+
+        return out;
+    }
+}
+
+TEST_CASE("Grayscale kernels are bit-exact across backends", "[kernels][grayscale]") {
+    std::mt19937 rng(42);
+
+    for (int channels: {1, 3, 4}) {
+        // Widths around every vector step so both the SIMD bodies and the scalar tails run.
+        for (int width: {1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 129, 1921}) {
+            std::vector<uint8_t> src(static_cast<size_t>(width) * channels);
+            for (auto& v: src) v = static_cast<uint8_t>(rng());
+
+            for (ChannelOrder order: {ChannelOrder::RGB, ChannelOrder::BGR}) {
+                const auto expected = referenceRow(src.data(), width, channels, order);
+
+                for (Backend backend: supportedBackends()) {
+                    std::vector<uint8_t> out(width);
+                    grayscaleRow(backend, src.data(), out.data(), width, channels, order);
+
+                    INFO(backendName(backend) << " width " << width << " channels " << channels);
+                    REQUIRE(out == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Grayscale kernel keeps white and black exact", "[kernels][grayscale]") {
+    REQUIRE(grayPixel(255, 255, 255) == 255);
+    REQUIRE(grayPixel(0, 0, 0) == 0);
+    REQUIRE(GrayWeightR + GrayWeightG + GrayWeightB == 1 << GrayShift);
+}
+
+TEST_CASE("Grayscale kernel honours source stride", "[kernels][grayscale]") {
+    // 3x2 RGB pixels inside rows padded to 16 bytes.
+    std::vector<uint8_t> src(32, 0xAB);
+    const uint8_t row0[] = {10, 20, 30, 40, 50, 60, 7, 7, 7};
+    const uint8_t row1[] = {255, 0, 0, 0, 255, 0, 0, 0, 255};
+    std::copy(std::begin(row0), std::end(row0), src.begin());
+    std::copy(std::begin(row1), std::end(row1), src.begin() + 16);
+
+    std::vector<uint8_t> dst(6);
+    grayscale(src.data(), 16, dst.data(), 3, 3, 2, 3, ChannelOrder::RGB);
+
+    REQUIRE(dst == std::vector<uint8_t>{18, 48, 7, 76, 150, 29});
+}
+
+TEST_CASE("Image::toGrayscale and matGray share the kernel", "[kernels][grayscale]") {
+    LibGraphics::Image img(2, 1, 3, std::vector<uint8_t>{255, 0, 0, 0, 0, 255});
+
+    // toGrayscale reads RGB, matGray reads the same bytes as BGR.
+    REQUIRE(img.toGrayscale().data == std::vector<uint8_t>{76, 29});
+    REQUIRE(img.matGray().at<uint8_t>(0, 0) == 29);
+    REQUIRE(img.matGray().at<uint8_t>(0, 1) == 76);
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LibGraphics/kernels/Redact.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace LibGraphics::Kernels;
+using LibGraphics::Type::Rect;
+
+namespace {
+    constexpr int W = 67;
+    constexpr int H = 41;
+
+    std::vector<Rect> randomRects(std::mt19937& rng, int count) {
+        std::uniform_int_distribution<int> pos(-10, W), size(1, 25);
+
+        std::vector<Rect> rects;
+        for (int i = 0; i < count; ++i) rects.push_back({pos(rng), pos(rng) % (H + 10), size(rng), size(rng)});
+        return rects;
+    }
+
+    std::vector<uint8_t> coverage(const std::vector<Rect>& rects) {
+        std::vector<uint8_t> mask(W * H, 0);
+        for (const auto& r: rects)
+            for (int y = 0; y < H; ++y)
+                for (int x = 0; x < W; ++x)
+                    if (r.contains(x, y)) mask[y * W + x] = 1;
+        return mask;
+    }
+
+    std::vector<uint8_t> randomPixels(std::mt19937& rng, int channels) {
+        std::vector<uint8_t> px(static_cast<size_t>(W) * H * channels);
+        for (auto& v: px) v = static_cast<uint8_t>(rng());
+        return px;
+    }
+}
+
+TEST_CASE("mergeSpans covers each pixel exactly once", "[kernels][redact]") {
+    std::mt19937 rng(3);
+
+    for (int round = 0; round < 50; ++round) {
+        const auto rects = randomRects(rng, round % 12);
+        const auto mask = coverage(rects);
+
+        std::vector<uint8_t> seen(W * H, 0);
+        const RowSpan* prev = nullptr;
+        for (const auto& s: mergeSpans(rects, W, H)) {
+            REQUIRE(s.x0 < s.x1);
+            if (prev && prev->y == s.y) REQUIRE(prev->x1 < s.x0);  // disjoint and not touching
+            if (prev) REQUIRE(prev->y <= s.y);
+            for (int x = s.x0; x < s.x1; ++x) ++seen[s.y * W + x];
+            prev = &s;
+        }
+
+        REQUIRE(seen == mask);
+    }
+}
+
+TEST_CASE("mergeRects leaves boxes that are margin apart", "[kernels][redact]") {
+    std::mt19937 rng(5);
+
+    for (int round = 0; round < 50; ++round) {
+        const auto rects = randomRects(rng, 10);
+        const int margin = round % 4;
+        const auto boxes = mergeRects(rects, W, H, margin);
+
+        for (size_t i = 0; i < boxes.size(); ++i)
+            for (size_t j = i + 1; j < boxes.size(); ++j) {
+                const Rect grown{boxes[i].X - margin, boxes[i].Y - margin, boxes[i].Width + 2 * margin, boxes[i].Height + 2 * margin};
+                REQUIRE(grown.intersect(boxes[j]).area() == 0);
+            }
+
+        // Every input pixel is still inside some box.
+        const auto mask = coverage(rects);
+        for (int y = 0; y < H; ++y)
+            for (int x = 0; x < W; ++x) {
+                if (!mask[y * W + x]) continue;
+                bool inside = false;
+                for (const auto& b: boxes) inside = inside || b.contains(x, y);
+                REQUIRE(inside);
+            }
+    }
+}
+
+TEST_CASE("Span fills match a per-pixel reference", "[kernels][redact]") {
+    std::mt19937 rng(11);
+
+    for (int channels: {1, 3, 4}) {
+        const int colorChannels = channels == 4 ? 3 : channels;
+        const size_t stride = static_cast<size_t>(W) * channels;
+
+        for (int round = 0; round < 20; ++round) {
+            INFO("channels " << channels << " round " << round);
+
+            const auto rects = randomRects(rng, 1 + round % 8);
+            const auto mask = coverage(rects);
+            const auto spans = mergeSpans(rects, W, H);
+            const auto original = randomPixels(rng, channels);
+
+            auto at = [&](const std::vector<uint8_t>& px, int x, int y, int c) {
+                return static_cast<int>(px[y * stride + x * channels + c]);
+            };
+
+            {  // solid
+                const uint8_t color[3] = {12, static_cast<uint8_t>(round % 2 ? 12 : 200), 99};
+                auto out = original;
+                fillSpans(out.data(), stride, channels, colorChannels, spans, color);
+
+                auto expected = original;
+                for (int y = 0; y < H; ++y)
+                    for (int x = 0; x < W; ++x)
+                        if (mask[y * W + x])
+                            for (int c = 0; c < colorChannels; ++c) expected[y * stride + x * channels + c] = color[c];
+                REQUIRE(out == expected);
+            }
+
+            {  // pixelate
+                const int block = 1 + round % 9;
+                auto out = original;
+                pixelateSpans(out.data(), stride, W, channels, colorChannels, spans, block);
+
+                auto expected = original;
+                for (int y = 0; y < H; ++y)
+                    for (int x = 0; x < W; ++x) {
+                        if (!mask[y * W + x]) continue;
+                        const int cx = x / block * block, cy = y / block * block;
+                        for (int c = 0; c < colorChannels; ++c) {
+                            int sum = 0, n = 0;
+                            for (int v = cy; v < std::min(H, cy + block); ++v)
+                                for (int u = cx; u < std::min(W, cx + block); ++u)
+                                    if (mask[v * W + u]) sum += at(original, u, v, c), ++n;
+                            expected[y * stride + x * channels + c] = static_cast<uint8_t>((sum + n / 2) / n);
+                        }
+                    }
+                REQUIRE(out == expected);
+            }
+
+            {  // blur
+                const int radius = 1 + round % 6;
+                auto out = original;
+                blurSpans(out.data(), stride, W, H, channels, colorChannels, rects, spans, radius);
+
+                auto expected = original;
+                for (int y = 0; y < H; ++y)
+                    for (int x = 0; x < W; ++x) {
+                        if (!mask[y * W + x]) continue;
+                        for (int c = 0; c < colorChannels; ++c) {
+                            int sum = 0, n = 0;
+                            for (int v = std::max(0, y - radius); v <= std::min(H - 1, y + radius); ++v)
+                                for (int u = std::max(0, x - radius); u <= std::min(W - 1, x + radius); ++u)
+                                    sum += at(original, u, v, c), ++n;
+                            expected[y * stride + x * channels + c] = static_cast<uint8_t>((sum + n / 2) / n);
+                        }
+                    }
+                REQUIRE(out == expected);
+            }
+        }
+    }
+}
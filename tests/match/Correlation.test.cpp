@@ -0,0 +1,56 @@
+#include "LibGraphics/match/Correlation.hpp"
+#include "LibGraphics/Image.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <opencv2/opencv.hpp>
+
+using namespace LibGraphics::Match::Detail;
+
+TEST_CASE("TargetState keeps the spectra of shared regions only", "[Correlation]") {
+    cv::Mat target(60, 80, CV_8UC1);
+    cv::randu(target, 0, 256);
+    const cv::Mat templ = target(cv::Rect(30, 20, 12, 10)).clone();
+
+    cv::Mat sum, sqsum;
+    cv::integral(target, sum, sqsum, CV_64F, CV_64F);
+    const TargetState state(target, LibGraphics::IntegralImage(sum, sqsum), true);
+
+    const TemplateFormat format(templ);
+    const TemplateSpectra spectra(format);
+    const cv::Rect frame(0, 0, target.cols, target.rows);
+    const cv::Rect window(25, 15, 22, 20);
+
+    const cv::Mat refined = scoreMap(spectra, state, window, cv::TM_CCOEFF_NORMED, false);
+    REQUIRE(state.cachedRegions() == 0);
+
+    const cv::Mat shared = scoreMap(spectra, state, frame, cv::TM_CCOEFF_NORMED, true);
+    const cv::Mat again = scoreMap(spectra, state, frame, cv::TM_CCOEFF_NORMED, true);
+    REQUIRE(state.cachedRegions() == 1);
+    REQUIRE(cv::norm(shared, again, cv::NORM_INF) == 0.0);
+
+    // Same scores either way
+    REQUIRE(cv::norm(refined, shared(cv::Rect(25, 15, refined.cols, refined.rows)), cv::NORM_INF) < 1e-4);
+}
+
+TEST_CASE("TargetState over part of the target scores like the whole", "[Correlation]") {
+    LibGraphics::Image target = LibGraphics::Image::allocate(80, 60, 3);
+    cv::randu(target.mat(), 0, 256);
+    const cv::Mat templ = target.matGray()(cv::Rect(30, 20, 12, 10)).clone();
+
+    const cv::Rect frame(0, 0, target.width, target.height);
+    const cv::Rect bounds(20, 10, 40, 30);
+    const auto whole = TargetState::fromImage(target, 1, frame);
+    const auto part = TargetState::fromImage(target, 1, bounds);
+    REQUIRE(part->origin() == bounds.tl());
+    REQUIRE(part->mat().size() == bounds.size());
+    REQUIRE(part->tables().width() == bounds.width);
+
+    const TemplateFormat format(templ);
+    const TemplateSpectra spectra(format);
+    const cv::Rect region(25, 15, 30, 22);
+
+    const cv::Mat expected = scoreMap(spectra, *whole, region, cv::TM_CCOEFF_NORMED);
+    const cv::Mat scores = scoreMap(spectra, *part, region, cv::TM_CCOEFF_NORMED);
+    REQUIRE(cv::norm(expected, scores, cv::NORM_INF) < 1e-4);
+}
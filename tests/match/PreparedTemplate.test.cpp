@@ -0,0 +1,313 @@
+#include "LibGraphics/LibGraphics.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+using namespace LibGraphics;
+using namespace LibGraphics::Match;
+
+static Image noiseImage(int width, int height, int channels, unsigned seed) {
+    Image image = Image::allocate(width, height, channels);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = image.rowPtr(y);
+        for (int i = 0; i < width * channels; ++i) row[i] = static_cast<uint8_t>(dist(rng));
+    }
+    return image;
+}
+
+static Image cropImage(const Image& source, int x, int y, int width, int height) {
+    Image out = Image::allocate(width, height, source.channels);
+    for (int row = 0; row < height; ++row)
+        std::memcpy(out.rowPtr(row), source.rowPtr(y + row) + static_cast<size_t>(x) * source.channels,
+                    static_cast<size_t>(width) * source.channels);
+    return out;
+}
+
+static const int methods[] = {
+    cv::TM_SQDIFF, cv::TM_SQDIFF_NORMED, cv::TM_CCORR, cv::TM_CCORR_NORMED, cv::TM_CCOEFF, cv::TM_CCOEFF_NORMED
+};
+
+TEST_CASE("PreparedTemplate matches like the unprepared overloads", "[PreparedTemplate]") {
+    const Image target = noiseImage(97, 61, 3, 1);
+    const Image templ = cropImage(target, 40, 23, 17, 11);
+
+    for (int method : methods) {
+        MatchOptions options;
+        options.method(method);
+
+        const MatchResult expected = TemplateMatcher::matchTemplateSingle(templ, target, options);
+        const MatchResult actual = TemplateMatcher::matchTemplateSingle(PreparedTemplate(templ, options), target);
+
+        INFO("method " << method);
+        if (method != cv::TM_CCORR) {
+            // Plain correlation peaks on the brightest window, not necessarily on the crop.
+            REQUIRE(expected.X == 40);
+            REQUIRE(expected.Y == 23);
+            REQUIRE(actual.X == expected.X);
+            REQUIRE(actual.Y == expected.Y);
+        }
+        REQUIRE(actual.Width == 17);
+        REQUIRE(actual.Height == 11);
+
+        const double tolerance = std::max(1e-4, std::abs(expected.Score) * 1e-5);
+        REQUIRE_THAT(actual.Score, Catch::Matchers::WithinAbs(expected.Score, tolerance));
+    }
+}
+
+TEST_CASE("PreparedTemplate scores the whole map like cv::matchTemplate", "[PreparedTemplate]") {
+    // Smooth content, so the best match is not the only score that matters.
+    const std::filesystem::path assetsPath = "../tests/assets/match/single";
+    const Image target = Image::load((assetsPath / "lena.png").string());
+    const Image templ = Image::load((assetsPath / "lena_crop.png").string());
+
+    for (int method : {cv::TM_SQDIFF_NORMED, cv::TM_CCORR_NORMED, cv::TM_CCOEFF_NORMED}) {
+        MatchOptions options;
+        options.method(method);
+        options.minConfidence = 0.5;
+
+        const auto expected = TemplateMatcher::matchTemplateMultiple(templ, target, options);
+        const auto actual = TemplateMatcher::matchTemplateMultiple(PreparedTemplate(templ, options), target);
+
+        INFO("method " << method);
+        REQUIRE(!actual.empty());
+        REQUIRE(actual.front().X == expected.front().X);
+        REQUIRE(actual.front().Y == expected.front().Y);
+        REQUIRE_THAT(actual.front().Score, Catch::Matchers::WithinAbs(expected.front().Score, 1e-4));
+    }
+}
+
+TEST_CASE("PreparedTemplate converts between channel counts", "[PreparedTemplate]") {
+    const Image target = noiseImage(80, 50, 3, 2);
+    const Image crop = cropImage(target, 12, 30, 20, 14);
+
+    SECTION("BGRA template against a BGR target") {
+        Image templ = Image::allocate(crop.width, crop.height, 4);
+        for (int y = 0; y < crop.height; ++y)
+            for (int x = 0; x < crop.width; ++x) {
+                std::memcpy(templ.rowPtr(y) + x * 4, crop.rowPtr(y) + x * 3, 3);
+                templ.rowPtr(y)[x * 4 + 3] = 255;
+            }
+
+        const PreparedTemplate prepared(templ);
+        const MatchResult result = TemplateMatcher::matchTemplateSingle(prepared, target);
+        REQUIRE(result.X == 12);
+        REQUIRE(result.Y == 30);
+        REQUIRE_THAT(result.Score, Catch::Matchers::WithinAbs(1.0, 1e-4));
+    }
+
+    SECTION("Grayscale option") {
+        MatchOptions options;
+        options.grayscale = true;
+
+        const MatchResult expected = TemplateMatcher::matchTemplateSingle(crop, target, options);
+        const MatchResult actual = TemplateMatcher::matchTemplateSingle(PreparedTemplate(crop, options), target);
+        REQUIRE(actual.X == expected.X);
+        REQUIRE(actual.Y == expected.Y);
+        REQUIRE_THAT(actual.Score, Catch::Matchers::WithinAbs(expected.Score, 1e-4));
+    }
+
+    SECTION("Gray template against a BGR target") {
+        const cv::Mat gray = crop.matGray();
+        Image templ = Image::allocate(crop.width, crop.height, 1);
+        for (int y = 0; y < crop.height; ++y) std::memcpy(templ.rowPtr(y), gray.ptr<uint8_t>(y), crop.width);
+
+        const PreparedTemplate prepared(templ);
+        const MatchResult result = TemplateMatcher::matchTemplateSingle(prepared, target);
+        REQUIRE(result.X == 12);
+        REQUIRE(result.Y == 30);
+    }
+}
+
+TEST_CASE("PreparedTemplate accepts views and reuses its caches", "[PreparedTemplate]") {
+    const Image target = noiseImage(120, 90, 3, 3);
+    const PreparedTemplate prepared(cropImage(target, 70, 50, 16, 16));
+
+    SECTION("ImageView target reports view coordinates") {
+        const MatchResult result = TemplateMatcher::matchTemplateSingle(prepared, target.view(60, 40, 40, 40));
+        REQUIRE(result.X == 10);
+        REQUIRE(result.Y == 10);
+    }
+
+    SECTION("Repeated matches and other target sizes") {
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(TemplateMatcher::matchTemplateSingle(prepared, target).X == 70);
+            REQUIRE(TemplateMatcher::matchTemplateSingle(prepared, target.view(50, 30, 50, 50)).X == 20);
+        }
+    }
+
+    SECTION("withOptions shares the template") {
+        MatchOptions strict;
+        strict.minConfidence = 0.99;
+        const PreparedTemplate other = prepared.withOptions(strict);
+
+        REQUIRE(&other.image() == &prepared.image());
+        REQUIRE(other.options().minConfidence == 0.99);
+        REQUIRE(TemplateMatcher::matchTemplateMultiple(other, target).size() == 1);
+    }
+}
+
+TEST_CASE("PreparedTemplate error handling", "[PreparedTemplate]") {
+    REQUIRE_THROWS_AS(PreparedTemplate(Image()), std::invalid_argument);
+
+    const PreparedTemplate empty;
+    REQUIRE_FALSE(empty);
+    REQUIRE(empty.width() == 0);
+    REQUIRE_THROWS_AS(TemplateMatcher::matchTemplateSingle(empty, noiseImage(8, 8, 3, 4)), std::runtime_error);
+
+    const PreparedTemplate large(noiseImage(32, 32, 3, 5));
+    REQUIRE_THROWS_AS(TemplateMatcher::matchTemplateSingle(large, noiseImage(16, 16, 3, 6)), std::runtime_error);
+}
+
+TEST_CASE("PreparedTemplate pyramid mode", "[PreparedTemplate][pyramid]") {
+    const std::filesystem::path assetsPath = "../tests/assets/match/single";
+    const Image target = Image::load((assetsPath / "lena.png").string());
+    const Image templ = Image::load((assetsPath / "lena_crop.png").string());
+
+    MatchOptions options;
+    const MatchResult expected = TemplateMatcher::matchTemplateSingle(templ, target, options);
+
+    const PreparedTemplate prepared(templ, MatchOptions().pyramid(2));
+    const MatchResult result = TemplateMatcher::matchTemplateSingle(prepared, target);
+    REQUIRE(result.X == expected.X);
+    REQUIRE(result.Y == expected.Y);
+    REQUIRE_THAT(result.Score, Catch::Matchers::WithinAbs(expected.Score, 1e-4));
+
+    const MatchResult inView = TemplateMatcher::matchTemplateSingle(prepared, target.view(expected.X / 2, expected.Y / 2,
+                                                                                         target.width - expected.X / 2,
+                                                                                         target.height - expected.Y / 2));
+    REQUIRE(inView.X == expected.X - expected.X / 2);
+    REQUIRE(inView.Y == expected.Y - expected.Y / 2);
+}
+
+TEST_CASE("PreparedTemplate search regions", "[PreparedTemplate][regions]") {
+    const Image target = noiseImage(160, 120, 3, 7);
+    const Image templ = cropImage(target, 90, 60, 24, 20);
+
+    MatchOptions options(0.99);
+    options.region({80, 50, 60, 50});
+    const PreparedTemplate prepared(templ, options);
+
+    const MatchResult result = TemplateMatcher::matchTemplateSingle(prepared, target);
+    REQUIRE(result.X == 90);
+    REQUIRE(result.Y == 60);
+
+    const auto matches = TemplateMatcher::matchTemplateMultiple(prepared, target);
+    REQUIRE(matches.size() == 1);
+    REQUIRE(matches.front().X == 90);
+    REQUIRE(matches.front().Y == 60);
+
+    MatchOptions elsewhere(0.99);
+    elsewhere.region({0, 0, 60, 50});
+    REQUIRE_THROWS_AS(TemplateMatcher::matchTemplateSingle(prepared.withOptions(elsewhere), target),
+                      LibGraphics::Exceptions::LowConfidenceException);
+}
+
+TEST_CASE("TemplateMatcher::matchMany matches every template against one target", "[PreparedTemplate][matchMany]") {
+    const Image target = noiseImage(200, 150, 3, 8);
+
+    std::vector<PreparedTemplate> templates;
+    std::vector<cv::Point> expected;
+    for (int i = 0; i < 12; ++i) {
+        const int x = (i * 37) % 170, y = (i * 23) % 125;
+        templates.emplace_back(cropImage(target, x, y, 20 + i % 3, 18 + i % 4), MatchOptions(0.95));
+        expected.emplace_back(x, y);
+    }
+    // Not in the target: stays under its own threshold
+    templates.emplace_back(noiseImage(20, 20, 3, 9), MatchOptions(0.95));
+
+    SECTION("Per-template options") {
+        const auto results = TemplateMatcher::matchMany(templates, target);
+        REQUIRE(results.size() == templates.size());
+
+        for (size_t i = 0; i < expected.size(); ++i) {
+            INFO("template " << i);
+            REQUIRE(results[i].has_value());
+            REQUIRE(results[i]->X == expected[i].x);
+            REQUIRE(results[i]->Y == expected[i].y);
+            REQUIRE(results[i]->Width == templates[i].width());
+
+            const MatchResult single = TemplateMatcher::matchTemplateSingle(templates[i], target);
+            REQUIRE_THAT(results[i]->Score, Catch::Matchers::WithinAbs(single.Score, 1e-6));
+        }
+        REQUIRE_FALSE(results.back().has_value());
+    }
+
+    SECTION("Shared options") {
+        MatchOptions options;
+        options.method(cv::TM_SQDIFF_NORMED);
+
+        const auto results = TemplateMatcher::matchMany(templates, target.view(), options);
+        REQUIRE(results.size() == templates.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            REQUIRE(results[i].has_value());
+            REQUIRE(results[i]->X == expected[i].x);
+            REQUIRE(results[i]->Y == expected[i].y);
+        }
+        // No threshold: the unrelated template still gets its best location
+        REQUIRE(results.back().has_value());
+    }
+
+    SECTION("Empty and invalid input") {
+        REQUIRE(TemplateMatcher::matchMany({}, target).empty());
+
+        std::vector<PreparedTemplate> withEmpty = {templates.front(), PreparedTemplate()};
+        REQUIRE_THROWS_AS(TemplateMatcher::matchMany(withEmpty, target), std::runtime_error);
+
+        std::vector<PreparedTemplate> tooLarge = {PreparedTemplate(noiseImage(300, 20, 3, 10))};
+        REQUIRE_THROWS_AS(TemplateMatcher::matchMany(tooLarge, target), std::runtime_error);
+    }
+}
+
+TEST_CASE("PreparedTemplate tiled matching", "[PreparedTemplate][tiled]") {
+    const Image target = noiseImage(300, 220, 3, 11);
+
+    std::vector<PreparedTemplate> templates;
+    for (int i = 0; i < 6; ++i) {
+        MatchOptions options(0.95);
+        options.tiled(60);
+        templates.emplace_back(cropImage(target, 40 * i + 7, 30 * i + 3, 24, 18), options);
+    }
+
+    for (int i = 0; i < 6; ++i) {
+        const MatchResult result = TemplateMatcher::matchTemplateSingle(templates[i], target);
+        REQUIRE(result.X == 40 * i + 7);
+        REQUIRE(result.Y == 30 * i + 3);
+    }
+
+    const auto results = TemplateMatcher::matchMany(templates, target);
+    for (int i = 0; i < 6; ++i) {
+        REQUIRE(results[i].has_value());
+        REQUIRE(results[i]->X == 40 * i + 7);
+        REQUIRE(results[i]->Y == 30 * i + 3);
+    }
+}
+
+TEST_CASE("Prepared matchTemplateMultiple ignores grayscale like the Image overload", "[PreparedTemplate][grayscale]") {
+    // The template in colour at (10, 10), and its gray version at (70, 40)
+    Image target = noiseImage(120, 80, 3, 12);
+    const Image templ = noiseImage(24, 20, 3, 13);
+    const cv::Mat luma = templ.matGray();
+    for (int y = 0; y < templ.height; ++y) {
+        std::memcpy(target.rowPtr(10 + y) + 10 * 3, templ.rowPtr(y), templ.width * 3);
+        for (int x = 0; x < templ.width; ++x)
+            std::memset(target.rowPtr(40 + y) + (70 + x) * 3, luma.at<uint8_t>(y, x), 3);
+    }
+
+    MatchOptions options(0.95);
+    options.grayscale = true;
+
+    for (const auto& found : {TemplateMatcher::matchTemplateMultiple(templ, target, options),
+                              TemplateMatcher::matchTemplateMultiple(PreparedTemplate(templ, options), target)}) {
+        REQUIRE(found.size() == 1);
+        REQUIRE(found.front().X == 10);
+        REQUIRE(found.front().Y == 10);
+    }
+}
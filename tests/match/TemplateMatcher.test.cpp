@@ -258,4 +258,232 @@ TEST_CASE("matchTemplateMultiple with different matching methods", "[TemplateMat
 
         REQUIRE_FALSE(results.empty());
     }
-}
\ No newline at end of file
+}
+TEST_CASE("matchTemplateSingle accepts image views", "[TemplateMatcher][matchTemplateSingle][view]") {
+    const std::filesystem::path assetsPath = "../tests/assets/match/single";
+    Image targetImg = Image::load((assetsPath / "lena.png").string());
+
+    ImageView templateView = targetImg.view(100, 120, 64, 64);
+    ImageView searchView = targetImg.view(50, 50, 200, 200);
+
+    REQUIRE(templateView.isValid());
+    REQUIRE(searchView.isValid());
+
+    SECTION("Color match is relative to the searched view") {
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, searchView, MatchOptions(0.99));
+
+        REQUIRE(result.X == 50);
+        REQUIRE(result.Y == 70);
+        REQUIRE(result.Width == 64);
+        REQUIRE(result.Height == 64);
+    }
+
+    SECTION("Grayscale match on views") {
+        MatchOptions options(0.99);
+        options.grayscale = true;
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, searchView, options);
+
+        REQUIRE(result.X == 50);
+        REQUIRE(result.Y == 70);
+    }
+}
+
+TEST_CASE("matchTemplateSingle pyramid mode finds the full resolution match", "[TemplateMatcher][matchTemplateSingle][pyramid]") {
+    const std::filesystem::path assetsPath = "../tests/assets/match/single";
+    Image templateImg = Image::load((assetsPath / "lena_crop.png").string());
+    Image targetImg = Image::load((assetsPath / "lena.png").string());
+
+    for (int method : {cv::TM_SQDIFF_NORMED, cv::TM_CCORR_NORMED, cv::TM_CCOEFF_NORMED}) {
+        MatchOptions full;
+        full.method(method);
+        MatchOptions coarse = full;
+        coarse.pyramid(2);
+
+        INFO("method " << method);
+        auto expected = TemplateMatcher::matchTemplateSingle(templateImg, targetImg, full);
+        auto result = TemplateMatcher::matchTemplateSingle(templateImg, targetImg, coarse);
+
+        REQUIRE(result.X == expected.X);
+        REQUIRE(result.Y == expected.Y);
+        REQUIRE(result.Width == expected.Width);
+        REQUIRE(result.Height == expected.Height);
+        REQUIRE_THAT(result.Score, Catch::Matchers::WithinAbs(expected.Score, 1e-6));
+    }
+
+    SECTION("Image views") {
+        ImageView templateView = targetImg.view(100, 120, 64, 64);
+        ImageView searchView = targetImg.view(50, 50, 200, 200);
+
+        MatchOptions options(0.99);
+        options.pyramid(3, 2);
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, searchView, options);
+
+        REQUIRE(result.X == 50);
+        REQUIRE(result.Y == 70);
+    }
+
+    SECTION("Grayscale") {
+        MatchOptions options(0.99);
+        options.grayscale = true;
+        options.pyramid(2);
+        auto result = TemplateMatcher::matchTemplateSingle(targetImg.view(100, 120, 64, 64), targetImg.view(), options);
+
+        REQUIRE(result.X == 100);
+        REQUIRE(result.Y == 120);
+    }
+
+    SECTION("Confidence threshold applies to the refined score") {
+        MatchOptions options(0.99);
+        options.pyramid(2);
+        Image unrelated = targetImg.pyramidLevel(3);
+
+        REQUIRE_THROWS_AS(TemplateMatcher::matchTemplateSingle(unrelated, targetImg, options), LowConfidenceException);
+    }
+
+    SECTION("Small templates and targets fall back to a full search") {
+        MatchOptions options;
+        options.pyramid(4);
+
+        ImageView tiny = targetImg.view(10, 10, 12, 12);
+        auto result = TemplateMatcher::matchTemplateSingle(tiny, targetImg.view(), options);
+        REQUIRE(result.X == 10);
+        REQUIRE(result.Y == 10);
+
+        REQUIRE_THROWS_AS(TemplateMatcher::matchTemplateSingle(targetImg, templateImg, options), std::runtime_error);
+    }
+}
+
+TEST_CASE("Search regions restrict the match and keep full-frame coordinates", "[TemplateMatcher][regions]") {
+    const std::filesystem::path singlePath = "../tests/assets/match/single";
+    Image targetImg = Image::load((singlePath / "lena.png").string());
+    ImageView templateView = targetImg.view(100, 120, 64, 64);
+
+    SECTION("Single match inside a region") {
+        MatchOptions options(0.99);
+        options.region({80, 100, 120, 120});
+
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, targetImg.view(), options);
+        REQUIRE(result.X == 100);
+        REQUIRE(result.Y == 120);
+        REQUIRE(result.Width == 64);
+    }
+
+    SECTION("Best of several regions, clipped to the target") {
+        MatchOptions options(0.99);
+        options.region({-50, -50, 120, 120}).region({90, 110, 5000, 5000});
+
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, targetImg.view(), options);
+        REQUIRE(result.X == 100);
+        REQUIRE(result.Y == 120);
+    }
+
+    SECTION("Pyramid search inside a region") {
+        MatchOptions options(0.99);
+        options.pyramid(2).region({60, 60, 200, 200});
+
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, targetImg.view(), options);
+        REQUIRE(result.X == 100);
+        REQUIRE(result.Y == 120);
+    }
+
+    SECTION("A region without the template") {
+        MatchOptions options(0.99);
+        options.region({300, 300, 150, 150});
+
+        REQUIRE_THROWS_AS(TemplateMatcher::matchTemplateSingle(templateView, targetImg.view(), options), LowConfidenceException);
+    }
+
+    SECTION("Regions smaller than the template are skipped") {
+        MatchOptions options;
+        options.region({0, 0, 32, 32});
+
+        REQUIRE_THROWS_AS(TemplateMatcher::matchTemplateSingle(templateView, targetImg.view(), options), std::runtime_error);
+
+        options.region({100, 120, 64, 64});
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, targetImg.view(), options);
+        REQUIRE(result.X == 100);
+        REQUIRE(result.Y == 120);
+    }
+
+    SECTION("Multiple matches over overlapping regions") {
+        const std::filesystem::path multiplePath = "../tests/assets/match/multiple";
+        Image templateImg = Image::load((multiplePath / "tux_crop.png").string());
+        Image landscape = Image::load((multiplePath / "landscape.png").string());
+
+        const auto expected = TemplateMatcher::matchTemplateMultiple(templateImg, landscape, MatchOptions(0.8));
+        REQUIRE(expected.size() == 3);
+
+        MatchOptions options(0.8);
+        for (const auto& match : expected) {
+            options.region({match.X - 10, match.Y - 10, match.Width + 20, match.Height + 20});
+        }
+        options.region({expected[0].X - 5, expected[0].Y - 5, expected[0].Width + 10, expected[0].Height + 10});
+
+        auto results = TemplateMatcher::matchTemplateMultiple(templateImg, landscape, options);
+        REQUIRE(results.size() == 3);
+        for (size_t i = 0; i < results.size(); ++i) {
+            REQUIRE(results[i].X == expected[i].X);
+            REQUIRE(results[i].Y == expected[i].Y);
+        }
+
+        MatchOptions one(0.8);
+        one.region({expected[1].X - 10, expected[1].Y - 10, expected[1].Width + 20, expected[1].Height + 20});
+        results = TemplateMatcher::matchTemplateMultiple(templateImg, landscape, one);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].X == expected[1].X);
+        REQUIRE(results[0].Y == expected[1].Y);
+    }
+}
+
+TEST_CASE("Tiled matching gives the untiled results", "[TemplateMatcher][tiled]") {
+    SECTION("Single match") {
+        const std::filesystem::path assetsPath = "../tests/assets/match/single";
+        Image templateImg = Image::load((assetsPath / "lena_crop.png").string());
+        Image targetImg = Image::load((assetsPath / "lena.png").string());
+
+        for (int method : {cv::TM_SQDIFF, cv::TM_CCORR_NORMED, cv::TM_CCOEFF_NORMED}) {
+            MatchOptions full;
+            full.method(method);
+            MatchOptions tiled = full;
+            tiled.tiled(64);
+
+            INFO("method " << method);
+            auto expected = TemplateMatcher::matchTemplateSingle(templateImg, targetImg, full);
+            auto result = TemplateMatcher::matchTemplateSingle(templateImg, targetImg, tiled);
+
+            REQUIRE(result.X == expected.X);
+            REQUIRE(result.Y == expected.Y);
+            REQUIRE_THAT(result.Score, Catch::Matchers::WithinRel(expected.Score, 1e-4));
+        }
+    }
+
+    SECTION("Multiple matches across tile borders") {
+        const std::filesystem::path assetsPath = "../tests/assets/match/multiple";
+        Image templateImg = Image::load((assetsPath / "tux_crop.png").string());
+        Image targetImg = Image::load((assetsPath / "landscape.png").string());
+
+        const auto expected = TemplateMatcher::matchTemplateMultiple(templateImg, targetImg, MatchOptions(0.8));
+
+        MatchOptions options(0.8);
+        options.tiled(std::max(templateImg.width, templateImg.height) * 2);
+        const auto results = TemplateMatcher::matchTemplateMultiple(templateImg, targetImg, options);
+
+        REQUIRE(results.size() == expected.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            REQUIRE(results[i].X == expected[i].X);
+            REQUIRE(results[i].Y == expected[i].Y);
+        }
+    }
+
+    SECTION("Tiles inside search regions") {
+        Image targetImg = Image::load("../tests/assets/match/single/lena.png");
+        ImageView templateView = targetImg.view(300, 200, 40, 40);
+
+        MatchOptions options(0.99);
+        options.tiled(90).region({200, 150, 300, 300});
+        auto result = TemplateMatcher::matchTemplateSingle(templateView, targetImg.view(), options);
+
+        REQUIRE(result.X == 300);
+        REQUIRE(result.Y == 200);
+    }
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LibGraphics/memory/BufferPool.hpp"
+#include "LibGraphics/Image.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using LibGraphics::Image;
+using LibGraphics::Memory::BufferPool;
+using LibGraphics::Memory::PixelAllocator;
+
+TEST_CASE("BufferPool size classes", "[BufferPool]") {
+    REQUIRE(BufferPool::sizeClass(1) == 64);
+    REQUIRE(BufferPool::sizeClass(64) == 64);
+    REQUIRE(BufferPool::sizeClass(65) == 80);
+    REQUIRE(BufferPool::sizeClass(128) == 128);
+    REQUIRE(BufferPool::sizeClass(1920 * 1080 * 3) >= 1920 * 1080 * 3);
+    REQUIRE(BufferPool::sizeClass(1920 * 1080 * 3) < 1920 * 1080 * 3 * 5 / 4);
+}
+
+TEST_CASE("BufferPool reuses freed blocks", "[BufferPool]") {
+    auto pool = std::make_shared<BufferPool>();
+
+    void* first = pool->allocate(1000);
+    REQUIRE(reinterpret_cast<uintptr_t>(first) % PixelAllocator::Alignment == 0);
+    pool->deallocate(first, 1000);
+
+    void* second = pool->allocate(990);
+    REQUIRE(second == first);
+    pool->deallocate(second, 990);
+
+    auto stats = pool->stats();
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.hitRate() == 0.5);
+}
+
+TEST_CASE("BufferPool respects the cache limit", "[BufferPool]") {
+    LibGraphics::Memory::BufferPoolOptions options;
+    options.maxCachedBytes = 0;
+    BufferPool pool(options);  // not owned by a shared_ptr, so no thread cache either
+
+    void* block = pool.allocate(4096);
+    pool.deallocate(block, 4096);
+
+    REQUIRE(pool.stats().released == 1);
+    REQUIRE(pool.stats().cachedBytes == 0);
+
+    // A shared pool parks the block in the thread cache first; the flush at thread exit releases it.
+    auto shared = std::make_shared<BufferPool>(options);
+    uint64_t releasedBeforeExit = 0;
+    std::thread worker([&] {
+        void* parked = shared->allocate(4096);
+        shared->deallocate(parked, 4096);
+        releasedBeforeExit = shared->stats().released;
+    });
+    worker.join();
+
+    REQUIRE(releasedBeforeExit == 0);
+    REQUIRE(shared->stats().released == 1);
+    REQUIRE(shared->stats().cachedBytes == 0);
+}
+
+TEST_CASE("Image operations draw from the installed allocator", "[BufferPool][Image]") {
+    auto pool = std::make_shared<BufferPool>();
+    Image::setAllocator(pool);
+
+    {
+        Image frame(64, 64, 3, std::vector<uint8_t>(64 * 64 * 3, 100));
+        for (int i = 0; i < 10; ++i) {
+            Image gray = frame.toGrayscale();
+            Image part = frame.crop(8, 8, 32, 32);
+            REQUIRE(gray.isValid());
+            REQUIRE(part.isValid());
+        }
+    }
+
+    Image::setAllocator(nullptr);
+
+    auto stats = pool->stats();
+    REQUIRE(stats.hits > 0);
+    REQUIRE(stats.hits > stats.misses);
+    REQUIRE(Image::allocator() == PixelAllocator::heap());
+}
+
+TEST_CASE("BufferPool serves a steady Image loop from the thread cache", "[BufferPool][Image]") {
+    auto pool = std::make_shared<BufferPool>();
+    Image::setAllocator(pool);
+
+    {
+        Image frame(64, 64, 3, std::vector<uint8_t>(64 * 64 * 3, 100));
+        const auto step = [&] {
+            Image gray = frame.toGrayscale();
+            Image part = frame.crop(8, 8, 32, 32);
+            REQUIRE(gray.isValid());
+            REQUIRE(part.isValid());
+        };
+
+        step();
+        pool->resetStats();
+        for (int i = 0; i < 10; ++i) step();
+    }
+
+    Image::setAllocator(nullptr);
+
+    // Buffer headers have their own slots, so they do not push the pixels out.
+    auto stats = pool->stats();
+    REQUIRE(stats.misses == 0);
+    REQUIRE(stats.hits == stats.threadHits);
+    REQUIRE(stats.threadHits == 40);
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include "LibGraphics/type/PixelBuffer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+using LibGraphics::Type::PixelBuffer;
+
+TEST_CASE("PixelBuffer copies share storage", "[PixelBuffer]") {
+    PixelBuffer a{1, 2, 3, 4};
+    PixelBuffer b = a;
+
+    REQUIRE(a.constData() == b.constData());
+    REQUIRE(a.useCount() == 2);
+    REQUIRE(a == b);
+}
+
+TEST_CASE("PixelBuffer detaches on write", "[PixelBuffer]") {
+    PixelBuffer a{1, 2, 3, 4};
+    PixelBuffer b = a;
+
+    b[0] = 99;
+
+    REQUIRE(a.constData() != b.constData());
+    REQUIRE(a[0] == 1);
+    REQUIRE(b[0] == 99);
+    REQUIRE_FALSE(a.isShared());
+    REQUIRE_FALSE(b.isShared());
+}
+
+TEST_CASE("PixelBuffer const reads do not detach", "[PixelBuffer]") {
+    PixelBuffer a(16, 7);
+    const PixelBuffer b = a;
+
+    REQUIRE(b[3] == 7);
+    REQUIRE(std::as_const(a).data() == b.data());
+    REQUIRE(a.isShared());
+}
+
+TEST_CASE("PixelBuffer adopts a vector without copying", "[PixelBuffer]") {
+    std::vector<uint8_t> bytes(64, 5);
+    const uint8_t* original = bytes.data();
+
+    PixelBuffer buffer(std::move(bytes));
+
+    REQUIRE(buffer.size() == 64);
+    REQUIRE(buffer.constData() == original);
+}
+
+namespace {
+    int freed = 0;
+
+    void countingFree(void* ptr) {
+        ++freed;
+        std::free(ptr);
+    }
+}
+
+TEST_CASE("PixelBuffer adopts foreign memory with a deleter", "[PixelBuffer]") {
+    freed = 0;
+    auto* raw = static_cast<uint8_t*>(std::malloc(16));
+    std::fill(raw, raw + 16, uint8_t{3});
+
+    {
+        PixelBuffer buffer = PixelBuffer::adopt(raw, 16, countingFree);
+        PixelBuffer copy = buffer;
+
+        REQUIRE(buffer.constData() == raw);
+        REQUIRE(copy.constData() == raw);
+
+        buffer.resize(8);
+        REQUIRE(freed == 0);
+    }
+
+    REQUIRE(freed == 1);
+
+    PixelBuffer grown = PixelBuffer::adopt(static_cast<uint8_t*>(std::malloc(4)), 4, countingFree);
+    grown.resize(64, 1);
+
+    REQUIRE(freed == 2);
+    REQUIRE(grown.size() == 64);
+}
+
+TEST_CASE("PixelBuffer attachment compare-exchange publishes once", "[PixelBuffer]") {
+    PixelBuffer buffer{1, 2, 3};
+    PixelBuffer copy = buffer;
+
+    auto first = std::make_shared<int>(1);
+    std::shared_ptr<void> expected;
+    REQUIRE(buffer.compareExchangeAttachment(expected, first));
+    REQUIRE(copy.attachment() == first);
+
+    std::shared_ptr<void> stale;
+    REQUIRE_FALSE(copy.compareExchangeAttachment(stale, std::make_shared<int>(2)));
+    REQUIRE(stale == first);
+    REQUIRE(buffer.attachment() == first);
+
+    PixelBuffer empty;
+    std::shared_ptr<void> none;
+    REQUIRE_FALSE(empty.compareExchangeAttachment(none, first));
+}
+
+TEST_CASE("PixelBuffer resize and assign", "[PixelBuffer]") {
+    PixelBuffer a;
+    REQUIRE(a.empty());
+
+    a.resize(4, 9);
+    REQUIRE(a == std::vector<uint8_t>{9, 9, 9, 9});
+
+    PixelBuffer b = a;
+    b.assign(2, 1);
+
+    REQUIRE(a.size() == 4);
+    REQUIRE(b == std::vector<uint8_t>{1, 1});
+}